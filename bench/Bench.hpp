@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include <string_view>
+
+namespace info::parse::bench {
+  /**
+   * Keeps the compiler from optimizing away the computation
+   * of the value, without costing anything at runtime.
+   */
+  template<class T>
+  inline void keep(const T& value) {
+#if defined(__GNUC__)
+      asm volatile("" : : "r,m"(value) : "memory");
+#else
+      static volatile const void* sink;
+      sink = &value;
+#endif
+  }
+
+  /**
+   * The result of one benchmark
+   */
+  struct Result {
+      /// The name of the benchmark
+      std::string name;
+      /// The bytes processed by one run
+      std::size_t bytes;
+      /// The runs done in one sample
+      std::size_t iterations;
+      /// The median time of one run, in nanoseconds
+      double ns;
+  };
+
+  /**
+   * A minimal benchmark harness.
+   *
+   * Each benchmark is run in batches doubled in size until one
+   * batch takes the minimal time, then that batch is sampled a few
+   * times; the median of the samples is reported, so
+   * a stray interrupt does not count.
+   * Results are written as JSON, so they can be compared
+   * between builds by any tool.
+   */
+  class Bench {
+      /// Interface
+  public:
+      /**
+       * Runs the benchmark, if it passes the filter
+       *
+       * @param[in] name The name of the benchmark
+       * @param[in] bytes The bytes processed by one run of f, used
+       *                  to calculate the throughput; 0 if not meaningful
+       * @param[in] f The function to benchmark, called with no arguments
+       */
+      template<class F>
+      void run(const std::string& name, std::size_t bytes, F&& f);
+
+      /**
+       * Writes the results as a JSON array of objects
+       *
+       * @param[out] os The stream to write to
+       */
+      void report(std::ostream& os) const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the harness
+       *
+       * @param[in] filter Only the benchmarks whose name contains this are run
+       * @param[in] minTime The minimal time a sample shall take
+       * @param[in] samples The amount of samples taken
+       */
+      Bench(std::string filter, std::chrono::nanoseconds minTime, std::size_t samples);
+
+      /// Fields
+  private:
+      std::string _filter;
+      std::chrono::nanoseconds _minTime;
+      std::size_t _samples;
+      std::vector<Result> _results;
+  };
+
+  inline Bench::Bench(std::string filter, std::chrono::nanoseconds minTime, std::size_t samples)
+          : _filter(std::move(filter)),
+            _minTime(minTime),
+            _samples(samples == 0 ? 1 : samples) {}
+
+  template<class F>
+  void Bench::run(const std::string& name, std::size_t bytes, F&& f) {
+      using clock = std::chrono::steady_clock;
+      if (name.find(_filter) == std::string::npos)
+          return;
+
+      auto batch = [&](std::size_t iterations) {
+        auto begin = clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            f();
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - begin);
+      };
+
+      std::size_t iterations = 1;
+      batch(1); // warm up caches and lazily initialized state
+      while (batch(iterations) < _minTime) {
+          iterations *= 2;
+      }
+
+      std::vector<double> samples;
+      for (std::size_t i = 0; i < _samples; ++i) {
+          samples.push_back(static_cast<double>(batch(iterations).count()) / iterations);
+      }
+      std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+      _results.push_back({name, bytes, iterations, samples[samples.size() / 2]});
+  }
+
+  inline void Bench::report(std::ostream& os) const {
+      os << "[\n";
+      for (std::size_t i = 0; i < _results.size(); ++i) {
+          auto&& result = _results[i];
+          // Bytes per nanosecond is GB/s, which is 1000 MB/s
+          auto mbps = result.bytes == 0 ? 0.0 : 1000.0 * result.bytes / result.ns;
+          os << "  {\"name\": \"" << result.name << "\", "
+             << "\"bytes\": " << result.bytes << ", "
+             << "\"iterations\": " << result.iterations << ", "
+             << "\"ns_per_op\": " << result.ns << ", "
+             << "\"mb_per_s\": " << mbps << "}"
+             << (i + 1 == _results.size() ? "\n" : ",\n");
+      }
+      os << "]\n";
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "Bench.hpp"
+#include "Bench_Whitespace.hpp"
+#include "../include/info/parse/utils.hpp"
+
+namespace info::parse::bench {
+  /**
+   * The bundle exploding of the string parser before it was made
+   * single pass; erases and inserts each bundle in place, so it is
+   * quadratic in the amount of bundles.
+   */
+  inline std::string explodeBundlesLegacy(const std::string& args) {
+      std::string parsable(args);
+      std::size_t bundleStart = 0;
+      for (;;) {
+          bundleStart = parsable.find(" -", bundleStart);
+          if (bundleStart == std::string::npos) break;
+          if (parsable[bundleStart + 2] == '-' && ++bundleStart) continue;
+
+          std::size_t bundleEnd = parsable.find(' ', bundleStart + 1);
+          std::size_t bundleSize = bundleEnd - bundleStart - 1;
+          if (bundleSize <= 1 && ++bundleStart) continue;
+
+          std::string bundle = parsable.substr(bundleStart, bundleSize + 1);
+          parsable.erase(bundleStart, bundleSize + 1);
+          std::stringstream explodedBundleStream;
+          for (const auto& ch : bundle) {
+              unless (ch == ' ' || ch == '-') {
+                  explodedBundleStream << " -" << ch << ' ';
+              }
+          }
+          parsable.insert(bundleStart, explodedBundleStream.str());
+          bundleStart++;
+      }
+      return parsable;
+  }
+
+  /**
+   * Makes a command line of about the size, made of
+   * `-xvzf` style bundles, long options and values.
+   */
+  inline std::string makeBundledCommandLine(std::size_t size) {
+      static const char* const tokens[] = {
+              "-xvzf", "archive.tar.gz", "-dsa", "--verbose", "-I/usr/include", "-qO-", "file"
+      };
+      std::mt19937 rng(42);
+      std::uniform_int_distribution<std::size_t> token(0, std::size(tokens) - 1);
+      std::string line;
+      while (line.size() < size) {
+          line += ' ';
+          line += tokens[token(rng)];
+      }
+      line.resize(size);
+      return line;
+  }
+
+  /**
+   * Exploding the bundles of command lines from 1 KiB to ARG_MAX;
+   * the legacy version is only run up to 128 KiB, as it is quadratic.
+   */
+  inline void benchBundles(Bench& bench) {
+      std::vector<std::size_t> sizes{1024, 16 * 1024, 128 * 1024, argMax()};
+      std::string out;
+      for (auto size : sizes) {
+          auto line = makeBundledCommandLine(size);
+          auto suffix = "/" + std::to_string(size);
+
+          bench.run("bundles/explode" + suffix, size, [&] {
+            explodeBundles(line, out);
+            keep(out.data());
+          });
+          if (size <= 128 * 1024) {
+              bench.run("bundles/legacy" + suffix, size, [&] {
+                auto exploded = explodeBundlesLegacy(line);
+                keep(exploded.data());
+              });
+          }
+      }
+  }
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+
+#include "Bench.hpp"
+#include "../include/info/parse/OptionsParser.hpp"
+
+namespace info::parse::bench {
+  /**
+   * Makes the arguments of a compiler-like invocation
+   * with the given amount of `-I` and `-D` entries.
+   */
+  inline std::vector<std::string> makeIncludeArgs(std::size_t entries) {
+      std::vector<std::string> args{"cc", "--verbose", "-O2"};
+      for (std::size_t i = 0; i < entries; ++i) {
+          args.push_back(i % 2 == 0 ? "-I" : "-D");
+          args.push_back(i % 2 == 0 ? "/usr/include/lib" + std::to_string(i)
+                                    : "MACRO_" + std::to_string(i) + "=1");
+      }
+      args.emplace_back("main.c");
+      return args;
+  }
+
+  /**
+   * Parsing invocations with thousands of `-I` and `-D` entries,
+   * as a string and as argv.
+   */
+  inline void benchParse(Bench& bench) {
+      std::string include, define;
+      int optimize = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("optimize|O", &optimize)
+                    ("verbose|v", &verbose);
+
+      for (std::size_t entries : {100u, 1000u, 10000u}) {
+          auto args = makeIncludeArgs(entries);
+          std::string line(" ");
+          std::vector<const char*> argv;
+          for (auto&& arg : args) {
+              line += arg + ' ';
+              argv.push_back(arg.c_str());
+          }
+          auto suffix = "/" + std::to_string(entries);
+
+          bench.run("parse/string" + suffix, line.size(), [&] {
+            auto rest = parser.parse(line);
+            keep(rest.data());
+          });
+          std::vector<std::string_view> rest;
+          bench.run("parse/argv" + suffix, line.size(), [&] {
+            rest.clear();
+            parser.parse(static_cast<int>(argv.size()), argv.data(), rest);
+            keep(rest.data());
+          });
+      }
+  }
+
+  /**
+   * Parsing a batch of short command lines with parseMany,
+   * on one thread and on all hardware threads.
+   */
+  inline void benchParseMany(Bench& bench) {
+      std::string include, define;
+      int optimize = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("optimize|O", &optimize)
+                    ("verbose|v", &verbose);
+
+      std::vector<std::string> lines;
+      std::size_t bytes = 0;
+      for (std::size_t i = 0; i < 10000; ++i) {
+          std::string line(" ");
+          for (auto&& arg : makeIncludeArgs(i % 16)) {
+              line += arg + ' ';
+          }
+          bytes += line.size();
+          lines.push_back(std::move(line));
+      }
+
+      for (std::size_t threads : {1u, 0u}) {
+          auto name = threads == 0 ? std::string("parse/many/all")
+                                   : "parse/many/" + std::to_string(threads);
+          bench.run(name, bytes, [&] {
+            auto results = parser.parseMany(lines, threads);
+            keep(results.data());
+          });
+      }
+  }
+
+  /**
+   * Replaying recorded command lines: stored as makeMonolithArgs
+   * strings, unescaped and parsed one by one; and stored as frames
+   * of the binary argv format, parsed in place.
+   */
+  inline void benchReplay(Bench& bench) {
+      std::string include, define;
+      int optimize = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("optimize|O", &optimize)
+                    ("verbose|v", &verbose);
+
+      std::vector<std::string> monoliths;
+      std::size_t monolithBytes = 0;
+      std::string frames;
+      for (std::size_t i = 0; i < 10000; ++i) {
+          auto args = makeIncludeArgs(i % 16);
+          args.emplace_back("script with  spaces\n");
+          std::vector<std::string_view> views(args.begin(), args.end());
+          monoliths.push_back(makeMonolithArgs(views));
+          monolithBytes += monoliths.back().size();
+          encodeArgs(views, frames);
+      }
+
+      std::string line;
+      bench.run("parse/replay/monolith", monolithBytes, [&] {
+        for (auto&& monolith : monoliths) {
+            line = monolith;
+            arcItrStr(line);
+            auto rest = parser.parse(line);
+            keep(rest.data());
+        }
+      });
+      std::vector<std::string_view> rest;
+      bench.run("parse/replay/frame", frames.size(), [&] {
+        std::string_view left(frames);
+        while (!left.empty()) {
+            rest.clear();
+            left.remove_prefix(parser.parseFrame(left, rest));
+        }
+        keep(rest.data());
+      });
+  }
+
+  /**
+   * Arguments arriving one at a time: parsing everything received
+   * again after each new one, and feeding each to a stream once.
+   */
+  inline void benchStream(Bench& bench) {
+      std::string include, define;
+      int optimize = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("optimize|O", &optimize)
+                    ("verbose|v", &verbose);
+
+      for (std::size_t entries : {64u, 512u}) {
+          auto args = makeIncludeArgs(entries);
+          std::size_t bytes = 0;
+          for (auto&& arg : args) {
+              bytes += arg.size();
+          }
+
+          std::vector<std::string_view> received, rest;
+          bench.run("parse/stream/reparse/" + std::to_string(entries), bytes, [&] {
+            received.clear();
+            for (auto&& arg : args) {
+                received.emplace_back(arg);
+                rest.clear();
+                parser.parse(received, rest);
+            }
+            keep(rest.data());
+          });
+          auto stream = parser.stream();
+          bench.run("parse/stream/feed/" + std::to_string(entries), bytes, [&] {
+            stream.reset();
+            for (auto&& arg : args) {
+                stream.feed(arg);
+            }
+            stream.finish();
+            keep(stream.rest().data());
+          });
+      }
+  }
+
+  /**
+   * Parsing the same few thousand distinct command lines over and
+   * over, without a cache, and answered by the cache.
+   */
+  inline void benchCache(Bench& bench) {
+      std::string include, define;
+      int optimize = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("optimize|O", &optimize)
+                    ("verbose|v", &verbose);
+
+      std::vector<std::vector<std::string>> lines;
+      std::size_t bytes = 0;
+      for (std::size_t i = 0; i < 2000; ++i) {
+          auto args = makeIncludeArgs(4 + i % 16);
+          args.push_back("job" + std::to_string(i));
+          for (auto&& arg : args) {
+              bytes += arg.size();
+          }
+          lines.push_back(std::move(args));
+      }
+      std::vector<std::vector<const char*>> argvs;
+      for (auto&& args : lines) {
+          auto& argv = argvs.emplace_back();
+          for (auto&& arg : args) {
+              argv.push_back(arg.c_str());
+          }
+      }
+
+      std::vector<std::string_view> rest;
+      auto parseAll = [&] {
+        for (auto&& argv : argvs) {
+            rest.clear();
+            parser.parse(static_cast<int>(argv.size()), argv.data(), rest);
+        }
+        keep(rest.data());
+      };
+      bench.run("parse/cache/off", bytes, parseAll);
+      parser.cacheResults(4096);
+      bench.run("parse/cache/hit", bytes, parseAll);
+  }
+
+  /**
+   * Scanning a file of NUL-separated command lines: only splitting it,
+   * parsing the records in place, and copying each into a string to parse.
+   */
+  inline void benchCorpus(Bench& bench) {
+      std::string include, define;
+      int optimize = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("optimize|O", &optimize)
+                    ("verbose|v", &verbose);
+
+      auto path = (std::filesystem::temp_directory_path() / "ip_bench_corpus.bin").string();
+      {
+          std::ofstream file(path, std::ios::binary);
+          for (std::size_t i = 0; i < 50000; ++i) {
+              for (auto&& arg : makeIncludeArgs(i % 16)) {
+                  file.write(arg.c_str(), static_cast<std::streamsize>(arg.size() + 1));
+              }
+              file.put('\0');
+          }
+      }
+
+      {
+          CmdlineCorpus corpus(path);
+          auto bytes = corpus.data().size();
+          std::vector<std::string_view> args, rest;
+          bench.run("corpus/split", bytes, [&] {
+            corpus.rewind();
+            std::size_t count = 0;
+            while (corpus.next(args)) {
+                count += args.size();
+            }
+            keep(count);
+          });
+          bench.run("corpus/parse", bytes, [&] {
+            corpus.rewind();
+            while (corpus.next(args)) {
+                rest.clear();
+                parser.parse(args, rest);
+            }
+            keep(rest.data());
+          });
+          std::string line;
+          bench.run("corpus/string", bytes, [&] {
+            corpus.rewind();
+            while (corpus.next(args)) {
+                line = " ";
+                for (auto&& arg : args) {
+                    line += arg;
+                    line += ' ';
+                }
+                auto remains = parser.parse(line);
+                keep(remains.data());
+            }
+          });
+      }
+      std::remove(path.c_str());
+  }
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "Bench.hpp"
+#include "../include/info/parse/OptionsParser.hpp"
+
+namespace info::parse::bench {
+  /**
+   * Arguments kept alive as strings, with an argv
+   * pointing into them and the command line they make.
+   */
+  struct BenchArgs {
+      std::vector<std::string> args;
+      std::vector<const char*> argv;
+      std::string line;
+      std::size_t bytes = 0;
+
+      void push(std::string arg) {
+          args.push_back(std::move(arg));
+      }
+
+      void seal() {
+          line = " ";
+          for (auto&& arg : args) {
+              argv.push_back(arg.c_str());
+              line += arg + ' ';
+          }
+          bytes = line.size();
+      }
+  };
+
+  /**
+   * Runs parsing the arguments both as argv and as a string
+   */
+  inline void runParse(Bench& bench, const std::string& name,
+                       OptionsParser& parser, const BenchArgs& args) {
+      std::vector<std::string_view> rest;
+      bench.run(name + "/argv", args.bytes, [&] {
+        rest.clear();
+        parser.parse(static_cast<int>(args.argv.size()), args.argv.data(), rest);
+        keep(rest.data());
+      });
+      bench.run(name + "/string", args.bytes, [&] {
+        auto remains = parser.parse(args.line);
+        keep(remains.data());
+      });
+  }
+
+  /**
+   * Parsing as the amount of options, the names for each option,
+   * and the share of bundles among the arguments grow, and with
+   * options of each value type.
+   */
+  inline void benchScaling(Bench& bench) {
+      std::mt19937 rng(42);
+
+      // options registered; 200 arguments naming random options
+      for (std::size_t count : {10u, 100u, 1000u}) {
+          std::vector<int> values(count);
+          OptionsParser parser;
+          for (std::size_t i = 0; i < count; ++i) {
+              parser.addOption("option-" + std::to_string(i), &values[i]);
+          }
+          std::uniform_int_distribution<std::size_t> pick(0, count - 1);
+          BenchArgs args;
+          for (std::size_t i = 0; i < 100; ++i) {
+              args.push("--option-" + std::to_string(pick(rng)));
+              args.push(std::to_string(i));
+          }
+          args.seal();
+          runParse(bench, "scale/options/" + std::to_string(count), parser, args);
+      }
+
+      // building, freezing and tearing down a parser of that many options;
+      // and one of an OptionImage of them, in memory as if mapped
+      for (std::size_t count : {10u, 100u, 1000u}) {
+          std::vector<int> values(count);
+          std::vector<std::string> names;
+          for (std::size_t i = 0; i < count; ++i) {
+              names.push_back("option-" + std::to_string(i) + "|o" + std::to_string(i));
+          }
+          const char* argv[] = {"prog"};
+          bench.run("scale/construct/" + std::to_string(count), 0, [&] {
+            OptionsParser parser;
+            for (std::size_t i = 0; i < count; ++i) {
+                parser.addOption(names[i], &values[i]);
+            }
+            std::vector<std::string_view> rest;
+            parser.parse(1, argv, rest);
+            keep(rest.data());
+          });
+          auto bytes = OptionImage::build(names);
+          bench.run("scale/construct-image/" + std::to_string(count), 0, [&] {
+            auto image = OptionImage::inMemory(bytes);
+            OptionsParser parser(image);
+            for (std::size_t i = 0; i < count; ++i) {
+                parser.addOption(i, &values[i]);
+            }
+            std::vector<std::string_view> rest;
+            parser.parse(1, argv, rest);
+            keep(rest.data());
+          });
+      }
+
+      // names in each OptionString of 100 options; the last name is used
+      for (std::size_t names : {1u, 4u, 16u}) {
+          std::vector<int> values(100);
+          OptionsParser parser;
+          for (std::size_t i = 0; i < values.size(); ++i) {
+              std::string name = "option-" + std::to_string(i);
+              for (std::size_t n = 1; n < names; ++n) {
+                  name += "|alias-" + std::to_string(n) + "-" + std::to_string(i);
+              }
+              parser.addOption(name, &values[i]);
+          }
+          BenchArgs args;
+          for (std::size_t i = 0; i < values.size(); ++i) {
+              args.push(names == 1 ? "--option-" + std::to_string(i)
+                                   : "--alias-" + std::to_string(names - 1) + "-" + std::to_string(i));
+              args.push(std::to_string(i));
+          }
+          args.seal();
+          runParse(bench, "scale/names/" + std::to_string(names), parser, args);
+      }
+
+      // percentage of 1000 arguments that are bundles of single letter flags
+      for (unsigned density : {0u, 25u, 50u, 100u}) {
+          bool flags[26] = {};
+          OptionsParser parser;
+          for (char c = 'a'; c <= 'z'; ++c) {
+              parser.addOption(std::string("flag-") + c + '|' + c, &flags[c - 'a']);
+          }
+          std::uniform_int_distribution<int> letter(0, 25);
+          std::uniform_int_distribution<unsigned> percent(0, 99);
+          BenchArgs args;
+          for (std::size_t i = 0; i < 1000; ++i) {
+              if (percent(rng) < density) {
+                  std::string bundle("-");
+                  for (int k = 0; k < 3; ++k) {
+                      bundle += static_cast<char>('a' + letter(rng));
+                  }
+                  args.push(bundle);
+              } else {
+                  args.push("file" + std::to_string(i));
+              }
+          }
+          args.seal();
+          runParse(bench, "scale/bundles/" + std::to_string(density), parser, args);
+      }
+
+      // 500 options of each value type, each given once
+      constexpr std::size_t typed = 500;
+      auto typedArgs = [&](bool flag) {
+        BenchArgs args;
+        for (std::size_t i = 0; i < typed; ++i) {
+            args.push("--value-" + std::to_string(i));
+            unless (flag) {
+                args.push(std::to_string(i * 7));
+            }
+        }
+        args.seal();
+        return args;
+      };
+      {
+          std::deque<bool> values(typed);
+          OptionsParser parser;
+          for (std::size_t i = 0; i < typed; ++i) {
+              parser.addOption("value-" + std::to_string(i), &values[i]);
+          }
+          runParse(bench, "scale/type/bool", parser, typedArgs(true));
+      }
+      {
+          std::vector<int> values(typed);
+          OptionsParser parser;
+          for (std::size_t i = 0; i < typed; ++i) {
+              parser.addOption("value-" + std::to_string(i), &values[i]);
+          }
+          runParse(bench, "scale/type/int", parser, typedArgs(false));
+      }
+      {
+          std::vector<std::string> values(typed);
+          OptionsParser parser;
+          for (std::size_t i = 0; i < typed; ++i) {
+              parser.addOption("value-" + std::to_string(i), &values[i]);
+          }
+          runParse(bench, "scale/type/string", parser, typedArgs(false));
+      }
+      {
+          // only the raw values are kept; nothing is read
+          std::deque<LazyValue<int>> values(typed);
+          OptionsParser parser;
+          for (std::size_t i = 0; i < typed; ++i) {
+              parser.addOption("value-" + std::to_string(i), &values[i]);
+          }
+          runParse(bench, "scale/type/lazy", parser, typedArgs(false));
+          // and each found, then read
+          long sum = 0;
+          bench.run("scale/type/lazy/read", 0, [&] {
+            for (auto&& value : values) {
+                value.set("42");
+                sum += *value;
+            }
+            keep(&sum);
+          });
+      }
+      {
+          long sum = 0;
+          OptionsParser parser;
+          for (std::size_t i = 0; i < typed; ++i) {
+              parser.addOption<void, int>("value-" + std::to_string(i), [&](int v) { sum += v; });
+          }
+          runParse(bench, "scale/type/callback", parser, typedArgs(false));
+          keep(sum);
+      }
+  }
+}
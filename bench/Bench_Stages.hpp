@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <string_view>
+
+#include "Bench.hpp"
+#include "Bench_Parse.hpp"
+#include "../include/info/parse/utils.hpp"
+#include "../include/info/parse/Exporter_.hpp"
+#include "../include/info/parse/OptionHandler_.hpp"
+
+namespace info::parse::bench {
+  /**
+   * Makes an argument vector of the given length, where every
+   * fourth argument has something itrStr escapes.
+   */
+  inline std::vector<std::string> makeEscapableArgs(std::size_t length) {
+      std::vector<std::string> args;
+      for (std::size_t i = 0; i < length; ++i) {
+          args.push_back(i % 4 == 0 ? "quoted \"value\" " + std::to_string(i)
+                                    : "--plain-" + std::to_string(i));
+      }
+      return args;
+  }
+
+  /**
+   * The stages of parsing one by one: joining argv, escaping
+   * and unescaping, exporting values of each type, calling
+   * callbacks, and the regex based option handlers.
+   */
+  inline void benchStages(Bench& bench) {
+      for (std::size_t length : {16u, 256u, 4096u}) {
+          auto args = makeEscapableArgs(length);
+          std::vector<std::string_view> views(args.begin(), args.end());
+          std::size_t bytes = 0;
+          for (auto&& arg : args) {
+              bytes += arg.size() + 1;
+          }
+          auto suffix = "/" + std::to_string(length);
+
+          bench.run("stage/makeMonolithArgs" + suffix, bytes, [&] {
+            auto line = makeMonolithArgs(views);
+            keep(line.data());
+          });
+
+          std::string line;
+          for (auto&& arg : args) {
+              line += arg + ' ';
+          }
+          std::string escaped(line);
+          itrStr(escaped);
+          bench.run("stage/itrStr" + suffix, line.size(), [&] {
+            std::string copy(line);
+            itrStr(copy);
+            keep(copy.data());
+          });
+          bench.run("stage/arcItrStr" + suffix, escaped.size(), [&] {
+            std::string copy(escaped);
+            arcItrStr(copy);
+            keep(copy.data());
+          });
+      }
+
+      // an embedded script: mostly indentation and line breaks
+      std::string script;
+      for (std::size_t i = 0; i < 256; ++i) {
+          script += "    if [ -f \"$file" + std::to_string(i) + "\" ]; then\n"
+                    "        run   --level\t" + std::to_string(i) + "\n"
+                    "    fi\n\n";
+      }
+      std::wstring wideScript(script.begin(), script.end());
+      std::string escapedScript(script);
+      itrStr(escapedScript);
+      std::wstring wideEscapedScript(escapedScript.begin(), escapedScript.end());
+      bench.run("stage/itrStr/script", script.size(), [&] {
+        std::string copy(script);
+        itrStr(copy);
+        keep(copy.data());
+      });
+      bench.run("stage/arcItrStr/script", escapedScript.size(), [&] {
+        std::string copy(escapedScript);
+        arcItrStr(copy);
+        keep(copy.data());
+      });
+      bench.run("stage/itrStr/script/wide", script.size(), [&] {
+        std::wstring copy(wideScript);
+        itrStr(copy);
+        keep(copy.data());
+      });
+      bench.run("stage/arcItrStr/script/wide", escapedScript.size(), [&] {
+        std::wstring copy(wideEscapedScript);
+        arcItrStr(copy);
+        keep(copy.data());
+      });
+      std::vector<std::string_view> scriptArgs{"--eval", script, "--quiet"};
+      bench.run("stage/makeMonolithArgs/script", script.size(), [&] {
+        auto line = makeMonolithArgs(scriptArgs);
+        keep(line.data());
+      });
+
+      bool flag = false;
+      int number = 0;
+      std::string text;
+      detail::Exporter_<bool> boolExporter(&flag);
+      detail::Exporter_<int> intExporter(&number);
+      detail::Exporter_<std::string> stringExporter(&text);
+      bench.run("stage/export/bool", 1, [&] {
+        boolExporter("1");
+        keep(flag);
+      });
+      bench.run("stage/export/int", 6, [&] {
+        intExporter("123456");
+        keep(number);
+      });
+      bench.run("stage/export/string", 16, [&] {
+        stringExporter("/usr/include/lib");
+        keep(text.data());
+      });
+
+      int calls = 0;
+      detail::Exporter_<detail::none, void> voidCallback(
+              std::function<void()>([&] { ++calls; }));
+      detail::Exporter_<detail::none, int, int> intCallback(
+              std::function<int(int)>([&](int i) { return calls += i, 0; }));
+      detail::Exporter_<detail::none, void, std::string_view> viewCallback(
+              std::function<void(std::string_view)>([&](std::string_view s) { calls += s.size(); }));
+      bench.run("stage/callback/void", 0, [&] {
+        voidCallback("");
+        keep(calls);
+      });
+      bench.run("stage/callback/int", 6, [&] {
+        intCallback("123456");
+        keep(calls);
+      });
+      bench.run("stage/callback/string_view", 16, [&] {
+        viewCallback("/usr/include/lib");
+        keep(calls);
+      });
+
+      // the regex handlers the index replaced, one option each
+      auto handled = " " + makeMonolithArgs(std::vector<std::string_view>{
+              "cc", "--verbose", "--level", "3", "--include=/usr/include", "main.c"});
+      detail::OptionHandler_<bool> boolHandler;
+      boolHandler.addOption("verbose|v", &flag);
+      detail::OptionHandler_<int> intHandler;
+      intHandler.addOption("level|l", &number);
+      detail::OptionHandler_<std::string> stringHandler;
+      stringHandler.addOption("include|I", &text);
+      bench.run("stage/handler/bool", handled.size(), [&] {
+        auto rest = boolHandler.handle(handled);
+        keep(rest.data());
+      });
+      bench.run("stage/handler/int", handled.size(), [&] {
+        auto rest = intHandler.handle(handled);
+        keep(rest.data());
+      });
+      bench.run("stage/handler/string", handled.size(), [&] {
+        auto rest = stringHandler.handle(handled);
+        keep(rest.data());
+      });
+  }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <regex>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <unistd.h>
+#endif
+
+#include "Bench.hpp"
+#include "../include/info/parse/utils.hpp"
+
+namespace info::parse::bench {
+  /**
+   * The largest command line the system accepts, which is
+   * the largest input the string parser can be given from argv.
+   * Capped, as it scales with the stack size on some systems.
+   */
+  inline std::size_t argMax() {
+      std::size_t max = 2 * 1024 * 1024;
+#if defined(_SC_ARG_MAX)
+      auto sys = sysconf(_SC_ARG_MAX);
+      if (sys > 0)
+          max = static_cast<std::size_t>(sys);
+#endif
+      return std::min<std::size_t>(max, 8 * 1024 * 1024);
+  }
+
+  /**
+   * Makes a command line of about the size, like the ones
+   * the string parser sees: options, values and bundles
+   * separated by runs of whitespace.
+   */
+  inline std::string makeCommandLine(std::size_t size) {
+      static const char* const tokens[] = {
+              "--alpha", "-a", "42", "--text-overlay=Cocaine", "-dsa", "file.txt",
+              "--no-color", "-I/usr/include", "--verbose", "value", "-o", "out"
+      };
+      static const char* const gaps[] = {" ", "  ", "\t", " \n ", "   "};
+      std::mt19937 rng(42);
+      std::uniform_int_distribution<std::size_t> token(0, std::size(tokens) - 1);
+      std::uniform_int_distribution<std::size_t> gap(0, std::size(gaps) - 1);
+      std::string line;
+      while (line.size() < size) {
+          line += gaps[gap(rng)];
+          line += tokens[token(rng)];
+      }
+      line.resize(size);
+      return line;
+  }
+
+  /**
+   * Collapsing the whitespace of command lines from 1 KiB to ARG_MAX,
+   * with the kernel used by the library, against the regex it replaced.
+   * Build the library with INFO_NO_SIMD to compare against the scalar kernel.
+   */
+  inline void benchWhitespace(Bench& bench) {
+      std::vector<std::size_t> sizes{1024, 16 * 1024, 128 * 1024, argMax()};
+      std::string out;
+      for (auto size : sizes) {
+          auto line = makeCommandLine(size);
+          auto suffix = "/" + std::to_string(size);
+
+          bench.run("whitespace/collapse" + suffix, size, [&] {
+            collapseWhitespace(line, out);
+            keep(out.data());
+          });
+          bench.run("whitespace/regex" + suffix, size, [&] {
+            auto replaced = std::regex_replace(line, std::regex("\\s+"), " ");
+            keep(replaced.data());
+          });
+      }
+  }
+}
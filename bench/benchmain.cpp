@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+#include "Bench.hpp"
+#include "Bench_Whitespace.hpp"
+#include "Bench_Bundles.hpp"
+#include "Bench_Parse.hpp"
+#include "Bench_Stages.hpp"
+#include "Bench_Scaling.hpp"
+
+int main(int argc, char** argv) {
+    using namespace info::parse;
+    std::string filter, out;
+    int minTimeMs = 100;
+    int samples = 5;
+
+    OptionsParser parser;
+    parser.addOptions()
+                  ("filter|f", &filter)
+                  ("min-time|t", &minTimeMs)
+                  ("samples|s", &samples)
+                  ("out|o", &out);
+    parser.parse(argc - 1, argv + 1);
+
+    bench::Bench bench(filter, std::chrono::milliseconds(minTimeMs),
+                       static_cast<std::size_t>(samples));
+    bench::benchWhitespace(bench);
+    bench::benchBundles(bench);
+    bench::benchParse(bench);
+    bench::benchParseMany(bench);
+    bench::benchReplay(bench);
+    bench::benchStream(bench);
+    bench::benchCache(bench);
+    bench::benchCorpus(bench);
+    bench::benchStages(bench);
+    bench::benchScaling(bench);
+
+    if (out.empty()) {
+        bench.report(std::cout);
+    } else {
+        std::ofstream file(out);
+        bench.report(file);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "utils.hpp"
+
+namespace info::parse {
+  /**
+   * Appends the arguments to out as one frame of the binary argv format.
+   *
+   * A frame is the amount of arguments, then each argument as its
+   * length followed by its bytes as they are; both numbers are unsigned
+   * LEB128 varints, so short arguments take one byte of overhead.
+   * Nothing is escaped, so arguments may hold any bytes, NULs included.
+   * Frames can be concatenated into one buffer, which parseFrame() and
+   * decodeArgs() read one frame at a time.
+   *
+   * @code
+   * std::string log;
+   * info::parse::encodeArgs(argc, argv, log);
+   * // later
+   * std::vector<std::string_view> rest;
+   * std::string_view frames(log);
+   * while (!frames.empty()) {
+   *     frames.remove_prefix(parser.parseFrame(frames, rest));
+   * }
+   * @endcode
+   *
+   * @param[in] args The arguments to encode
+   * @param[out] out The string to append the frame to
+   */
+  void encodeArgs(const std::vector<std::string_view>& args, std::string& out);
+
+  /**
+   * @copydoc encodeArgs(const std::vector<std::string_view>&, std::string&)
+   * @param[in] argc The length of argv
+   * @param[in] argv The arguments to encode
+   */
+  void encodeArgs(int argc, const char* const* argv, std::string& out);
+
+  /**
+   * Reads the first frame of the buffer.
+   *
+   * @param[in] frames The buffer, starting with a frame
+   * @param[out] args The arguments of the frame are appended to this,
+   *                  as views into the buffer; not if it throws
+   * @return The size of the frame in bytes
+   * @throws std::invalid_argument if the frame is truncated or malformed
+   */
+  std::size_t decodeArgs(std::string_view frames, std::vector<std::string_view>& args);
+
+  namespace detail {
+    /**
+     * Reads the arguments of one frame in place, one by one.
+     * The whole frame is checked when the reader is made, so a
+     * malformed frame is rejected before any argument is read.
+     *
+     * @see encodeArgs()
+     */
+    class ArgFrameReader_ {
+        /// Interface
+    public:
+        /**
+         * Reads the next argument of the frame
+         *
+         * @param[out] arg The argument, a view into the buffer
+         * @return Whether there was an argument left; if not, arg is
+         *         not modified
+         */
+        bool next(std::string_view& arg);
+
+        /**
+         * Returns the amount of bytes read from the buffer; the size
+         * of the frame once all arguments are read
+         */
+        _retpure std::size_t consumed() const;
+
+        /// Lifecycle
+    public:
+        /**
+         * Starts reading the first frame of the buffer
+         *
+         * @param[in] frames The buffer, starting with a frame
+         * @throws std::invalid_argument if the frame is truncated
+         *         or malformed
+         */
+        explicit ArgFrameReader_(std::string_view frames);
+
+        /// Fields
+    private:
+        /// The buffer read
+        std::string_view _frames;
+        /// The position of the next byte to read
+        std::size_t _pos = 0;
+        /// The amount of arguments not yet read
+        std::uint64_t _left;
+
+        /// Methods
+    private:
+        std::uint64_t readVarint();
+    };
+  }
+}
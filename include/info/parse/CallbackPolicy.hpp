@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+
+#include "config.hpp"
+#include "utils.hpp"
+
+namespace info::parse {
+  /**
+   * How many times a callback is called with the value of its option.
+   *
+   * By default every callback is called exactly once, whatever it
+   * returns. A policy of more than one attempt retries callbacks which
+   * report failure by their return value, waiting more and more between
+   * the attempts, up to maxBackoff, until one succeeds or the attempts
+   * run out.
+   * Failure is reported by
+   *  - returning `false` if the callback returns something convertible
+   *    to bool, but not to int, or bool itself;
+   *  - returning a null pointer if it returns a pointer;
+   *  - returning non-zero if it returns something convertible to int,
+   *    like a C style status code.
+   *
+   * Other return types, and exceptions, are never retried: an exception
+   * thrown by the callback leaves the parse as it always did.
+   *
+   * If the library is configured with `INFO_RETRY_FAILED_CALLBACK_FUNCTION`,
+   * the default is one retry without waiting, instead of none.
+   *
+   * @code
+   * parser.addOption<bool, const std::string&>("connect|c", connect)
+   *       .withPolicy(info::parse::CallbackPolicy::retry(3, std::chrono::milliseconds(50)));
+   * @endcode
+   */
+  struct CallbackPolicy {
+      /// The most times the callback is called; at least once
+      unsigned attempts = config::RetryFailedCallback ? 2 : 1;
+      /// The wait before the first retry; doubled before each next one
+      std::chrono::milliseconds backoff{0};
+
+      /// The longest the wait grows to by doubling; a longer first
+      /// wait is kept as is
+      static constexpr std::chrono::milliseconds maxBackoff{10000};
+
+      /**
+       * Calls the callback exactly once, never checking what it returns
+       */
+      _retval static constexpr CallbackPolicy once();
+
+      /**
+       * Calls the callback until it succeeds, at most attempts times
+       *
+       * @param[in] attempts The most times to call the callback
+       * @param[in] backoff The wait before the first retry; doubled
+       *                    before each next one, up to maxBackoff
+       */
+      _retval static constexpr CallbackPolicy retry(unsigned attempts,
+                                                    std::chrono::milliseconds backoff = {});
+  };
+
+  inline constexpr CallbackPolicy CallbackPolicy::once() {
+      return {1, std::chrono::milliseconds(0)};
+  }
+
+  inline constexpr CallbackPolicy CallbackPolicy::retry(unsigned attempts,
+                                                        std::chrono::milliseconds backoff) {
+      return {attempts, backoff};
+  }
+
+  namespace detail {
+    /**
+     * Whether the return value of a callback tells if it succeeded
+     */
+    template<class R>
+    inline constexpr bool reports_success_v = std::is_pointer_v<R>
+                                              || std::is_convertible_v<R, bool>
+                                              || std::is_convertible_v<R, int>;
+
+    /**
+     * Tells whether the value returned by a callback means success
+     *
+     * @see CallbackPolicy
+     */
+    template<class R>
+    inline bool succeeded(const R& ret) {
+        if constexpr (std::is_pointer_v<R>) {
+            return ret != nullptr;
+        } else if constexpr (std::is_same_v<R, bool>
+                             || (std::is_convertible_v<R, bool> && !std::is_convertible_v<R, int>)) {
+            return static_cast<bool>(ret);
+        } else {
+            return static_cast<int>(ret) == 0;
+        }
+    }
+
+    /**
+     * Whether the type is a character type, ignoring cv-qualifiers
+     */
+    template<class C, class Bare = std::remove_cv_t<C>>
+    inline constexpr bool is_character_v = std::is_same_v<Bare, char>
+                                           || std::is_same_v<Bare, signed char>
+                                           || std::is_same_v<Bare, unsigned char>
+                                           || std::is_same_v<Bare, wchar_t>
+                                           || std::is_same_v<Bare, char16_t>
+                                           || std::is_same_v<Bare, char32_t>;
+
+    /**
+     * Whether a pointer returned by a callback may be deleted: it points
+     * to an object, but not to characters, which are most likely
+     * string literals
+     */
+    template<class R>
+    inline constexpr bool is_deletable_return_v = std::is_pointer_v<R>
+                                                  && std::is_object_v<std::remove_pointer_t<R>>
+                                                  && !is_character_v<std::remove_pointer_t<R>>;
+
+    /**
+     * Returns the wait before the retry after the one waited for
+     *
+     * @see CallbackPolicy::maxBackoff
+     */
+    inline std::chrono::milliseconds nextBackoff(std::chrono::milliseconds backoff) {
+        if (backoff >= CallbackPolicy::maxBackoff)
+            return backoff;
+        return std::min(backoff * 2, CallbackPolicy::maxBackoff);
+    }
+
+    /**
+     * Calls the callback as the policy says: once if what it returns
+     * tells nothing, otherwise until it succeeds or runs out of
+     * attempts.
+     *
+     * @tparam DeleteReturn Whether returned pointers to objects are
+     *                      deleted, as the callbacks of options are if the
+     *                      library is configured to; exporter functions
+     *                      keep theirs
+     * @param[in] policy The policy to call by
+     * @param[in] call Calls the callback with its arguments, returning
+     *                 whatever the callback returns
+     */
+    template<bool DeleteReturn = false, class F>
+    inline void callWithPolicy(const CallbackPolicy& policy, F&& call) {
+        using R = decltype(call());
+        if constexpr (!reports_success_v<R>) {
+            call();
+        } else {
+            auto backoff = policy.backoff;
+            for (unsigned attempt = 1;; ++attempt) {
+                R ret = call();
+                bool ok = succeeded(ret);
+                if constexpr (DeleteReturn && is_deletable_return_v<R>) {
+                    delete ret;
+                }
+                if (ok || attempt >= policy.attempts)
+                    return;
+                if (backoff.count() > 0) {
+                    std::this_thread::sleep_for(backoff);
+                    backoff = nextBackoff(backoff);
+                }
+            }
+        }
+    }
+  }
+}
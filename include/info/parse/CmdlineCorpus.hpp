@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+#include "utils.hpp"
+#include "MappedFile_.hpp"
+
+namespace info::parse {
+  /**
+   * Reads a corpus of command lines stored as NUL-separated arguments,
+   * like the contents of `/proc/<pid>/cmdline` files written one after
+   * the other, without copying any of them.
+   *
+   * Each argument is ended by a NUL, and each record by one more NUL;
+   * so a record is the contents of a `cmdline` file followed by a NUL.
+   * Empty records are skipped. The last record and its last argument
+   * may end at the end of the file without their NULs.
+   *
+   * The format cannot tell an empty argument from the end of a record:
+   * a process started as `prog "" x` has `prog\0\0x\0` as its
+   * `cmdline`, which is read as the two records `prog` and `x`. So a
+   * record is one process only if none of its arguments are empty;
+   * the empty arguments are lost either way.
+   *
+   * Files are memory-mapped where possible and read whole otherwise. The
+   * arguments are views into the file's memory, and are valid as long as
+   * the corpus is. They can be handed straight to OptionsParser::parse()
+   * or CompiledParser::parse().
+   *
+   * @code
+   * info::parse::CmdlineCorpus corpus("snapshots.bin");
+   * std::vector<std::string_view> args, rest;
+   * while (corpus.next(args)) {
+   *     rest.clear();
+   *     parser.parse(args, rest);
+   * }
+   * @endcode
+   */
+  class CmdlineCorpus {
+      /// Interface
+  public:
+      /**
+       * Reads the next record
+       *
+       * @param[out] args The arguments of the record replace its contents
+       * @return Whether there was a record left; if not, args is empty
+       */
+      bool next(std::vector<std::string_view>& args);
+
+      /**
+       * Reads the next record without splitting it into arguments
+       *
+       * @param[out] record The arguments of the record, each followed
+       *             by a NUL, except maybe the last one at the end of the file
+       * @return Whether there was a record left
+       */
+      bool next(std::string_view& record);
+
+      /**
+       * Starts reading from the first record again
+       */
+      void rewind();
+
+      /**
+       * Returns the whole corpus
+       */
+      _retpure std::string_view data() const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Maps the file into memory
+       *
+       * @param[in] path The path of the file
+       * @throws std::system_error if the file cannot be opened or mapped
+       */
+      explicit CmdlineCorpus(const std::string& path);
+
+      /**
+       * Reads a corpus already in memory
+       *
+       * @param[in] data The corpus; has to outlive the object
+       */
+      _retval static CmdlineCorpus inMemory(std::string_view data);
+
+      CmdlineCorpus(CmdlineCorpus&&) noexcept = default;
+      CmdlineCorpus& operator=(CmdlineCorpus&&) noexcept = default;
+
+      /// Fields
+  private:
+      /// The corpus
+      detail::MappedFile_ _file;
+      /// The position of the next record
+      std::size_t _pos = 0;
+
+      /// Methods
+  private:
+      explicit CmdlineCorpus(detail::MappedFile_ file);
+  };
+}
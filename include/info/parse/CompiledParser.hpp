@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+#include "utils.hpp"
+#include "OptionIndex_.hpp"
+#include "ParseSession_.hpp"
+#include "ParseResult.hpp"
+#include "WorkPool_.hpp"
+
+namespace info::parse {
+  class OptionsParser;
+
+  /**
+   * An immutable snapshot of the options of an OptionsParser,
+   * which can parse on any amount of threads at once.
+   *
+   * Everything needed for parsing is built when the snapshot is made,
+   * and never changes later: parsing only reads the shared options,
+   * and writes only into the ParseResult of the call. No option
+   * is exported; results are exported by OptionsParser::apply(), or
+   * queried directly.
+   *
+   * Copying is cheap, copies share the same options.
+   *
+   * @code
+   * auto compiled = parser.compile();
+   * // on any thread:
+   * auto result = compiled.parse(argc, argv);
+   * auto level = result.get<int>(0);
+   * @endcode
+   *
+   * @see OptionsParser::compile()
+   */
+  class CompiledParser {
+      /// Interface
+  public:
+      /**
+       * Parses the given string as if it was directly input from
+       * the local shell, the same way OptionsParser::parse() does
+       *
+       * @param[in] args The string to parse
+       * @return The values found and the arguments remaining
+       */
+      _retval ParseResult parse(std::string_view args) const;
+
+      /**
+       * @copydoc parse(std::string_view) const
+       * @param[out] result The result to overwrite; reusing a result
+       *             between calls reuses its memory, so once warmed up on
+       *             a thread, parsing does not allocate, however many
+       *             options there are
+       */
+      void parse(std::string_view args, ParseResult& result) const;
+
+      /**
+       * Parses the given arguments using parameters in
+       * the style of `int main` parameters
+       *
+       * @param[in] argc The length of argv
+       * @param[in] argv An array of char arrays which store the
+       *             parameters split up by the local shell
+       * @return The values found and the arguments remaining;
+       *         remaining arguments are joined and escaped as by
+       *         makeMonolithArgs, like OptionsParser::parse(int, char**)
+       *         returns them
+       */
+      _retval ParseResult parse(int argc, const char* const* argv) const;
+
+      /**
+       * @copydoc parse(int, const char* const*) const
+       * @param[out] result The result to overwrite; reusing a result
+       *             between calls reuses its memory
+       */
+      void parse(int argc, const char* const* argv, ParseResult& result) const;
+
+      /**
+       * Parses arguments already split, like the records of a
+       * CmdlineCorpus, the same way argv is parsed
+       *
+       * @param[in] args The arguments
+       * @param[out] result The result to overwrite; reusing a result
+       *             between calls reuses its memory
+       */
+      void parse(const std::vector<std::string_view>& args, ParseResult& result) const;
+
+      /**
+       * Parses the first frame of arguments in the binary argv format,
+       * in place, the same way OptionsParser::parseFrame() does
+       *
+       * @param[in] frames The buffer, starting with a frame made by
+       *                   encodeArgs(); nothing in result refers to it
+       * @param[out] result The result to overwrite; reusing a result
+       *             between calls reuses its memory
+       * @return The size of the frame in bytes
+       * @throws std::invalid_argument if the frame is truncated or malformed
+       */
+      std::size_t parseFrame(std::string_view frames, ParseResult& result) const;
+
+      /**
+       * Parses a batch of strings on multiple threads
+       *
+       * @copydetails OptionsParser::parseMany()
+       */
+      template<class Range>
+      _retval std::vector<ParseResult> parseMany(const Range& lines,
+                                                 std::size_t threads = 0) const;
+
+      /// Lifecycle
+  private:
+      friend class OptionsParser;
+
+      /**
+       * Constructs the snapshot from the options of a parser
+       *
+       * @param[in] index The frozen options to copy
+       */
+      explicit CompiledParser(const detail::OptionIndex_& index);
+
+      /// Fields
+  private:
+      /// The options, never modified after construction
+      std::shared_ptr<const detail::OptionIndex_> _index;
+  };
+
+  template<class Range>
+  std::vector<ParseResult> CompiledParser::parseMany(const Range& lines,
+                                                     std::size_t threads) const {
+      std::vector<std::string_view> views;
+      for (auto&& line : lines) {
+          views.emplace_back(line);
+      }
+      std::vector<ParseResult> results(views.size());
+
+      // what a worker keeps for all the lines it parses
+      struct Worker {
+          Worker(const detail::OptionIndex_& index, ParseResult& first)
+                  : sink(first, false),
+                    session(index, sink, scratch.used) {}
+
+          detail::StringScratch_ scratch;
+          detail::RecordingSink_ sink;
+          detail::ParseSession_<detail::RecordingSink_> session;
+      };
+
+      auto& pool = detail::WorkPool_::shared();
+      std::vector<std::optional<Worker>> workers(pool.workersFor(views.size(), threads));
+      const detail::OptionIndex_& index = *_index;
+      pool.run(views.size(), [&](std::size_t self, std::size_t begin, std::size_t end) {
+        auto& worker = workers[self];
+        unless (worker) {
+            worker.emplace(index, results[begin]);
+        }
+        for (auto i = begin; i < end; ++i) {
+            worker->sink.retarget(results[i]);
+            worker->session.reset();
+            detail::feedString(views[i], worker->scratch, worker->session);
+            worker->session.finish();
+        }
+      }, threads);
+      return results;
+  }
+}
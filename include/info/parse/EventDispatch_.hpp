@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "utils.hpp"
+#include "OptionIndex_.hpp"
+
+namespace info::parse {
+  /**
+   * Runs tasks, possibly on other threads. It is called with each
+   * task to run, and may run it whenever and wherever it wants;
+   * the parser waits for all of them when it needs to.
+   *
+   * @code
+   * parser.setExecutor([&pool](std::function<void()> task) {
+   *     pool.post(std::move(task));
+   * });
+   * @endcode
+   */
+  using Executor = std::function<void(std::function<void()>)>;
+
+  namespace detail {
+    /**
+     * An option found with its value, waiting to be handed to the option.
+     */
+    struct ParseEvent_ {
+        /// The index of the option
+        std::size_t option;
+        /// The value found; a view into the parsed arguments
+        std::string_view value;
+    };
+
+    /**
+     * Sink for ParseSession_ that gathers the found values as events
+     * instead of handing them over right away, so they can be
+     * dispatched as one batch once the arguments are all parsed.
+     */
+    class EventSink_ {
+        /// Interface
+    public:
+        /**
+         * Stores the event of the value found for the option
+         *
+         * @param[in] option The index of the option
+         * @param[in] value The value found for the option
+         */
+        void match(std::size_t option, std::string_view value);
+
+        /**
+         * Stores an argument that did not belong to any option
+         *
+         * @param[in] arg The argument
+         */
+        void rest(std::string_view arg);
+
+        /// Lifecycle
+    public:
+        /**
+         * Constructs the sink
+         *
+         * @param[out] events The collection to append the events to
+         * @param[out] rest The collection to store the remaining arguments in
+         */
+        EventSink_(std::vector<ParseEvent_>& events, std::vector<std::string_view>& rest);
+
+        /// Fields
+    private:
+        /// The events gathered
+        std::vector<ParseEvent_>& _events;
+        /// The remaining arguments
+        std::vector<std::string_view>& _rest;
+    };
+
+    /**
+     * Event buffers for nested parses, reused between parses.
+     *
+     * A callback may parse with the same parser while its own batch is
+     * being dispatched, like a `--config` option parsing the file it
+     * loads; so each nesting level leases a buffer of its own.
+     */
+    class EventBuffers_ {
+        /**
+         * The buffers of one nesting level
+         */
+        struct Level {
+            /// The events of the parse
+            std::vector<ParseEvent_> events;
+            /// The options used by the parse
+            std::vector<std::uint64_t> used;
+        };
+
+        /// Interface
+    public:
+        /**
+         * The buffer of one level, given back when destructed
+         */
+        class Lease {
+            /// Interface
+        public:
+            /**
+             * Returns the buffer leased; empty
+             */
+            _retpure std::vector<ParseEvent_>& events() const;
+
+            /**
+             * Returns the bitset of the options used by the session
+             * parsing into this level; kept between parses, so a
+             * session does not allocate it again
+             */
+            _retpure std::vector<std::uint64_t>& used() const;
+
+            /// Lifecycle
+        public:
+            explicit Lease(EventBuffers_& buffers);
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            ~Lease();
+
+            /// Fields
+        private:
+            EventBuffers_& _buffers;
+            Level& _level;
+        };
+
+        /// Lifecycle
+    public:
+        EventBuffers_() = default;
+
+        /// Buffers are not shared between copies of a parser
+        EventBuffers_(const EventBuffers_&);
+        EventBuffers_& operator=(const EventBuffers_&);
+
+        /// Fields
+    private:
+        /// One buffer for each nesting level; never shrinks, and
+        /// references to its elements stay valid when it grows
+        std::deque<Level> _levels;
+        /// The levels leased
+        std::size_t _depth = 0;
+
+        /// Methods
+    private:
+        Level& acquire();
+    };
+
+    /**
+     * Hands the values of the events to their options, in order.
+     *
+     * Events of options marked independent are run on the executor, if
+     * any, while the events around them are not: all independent events
+     * in a row are submitted, then waited for before the next event
+     * of an option that is not independent is handed over. So
+     * independent options run in parallel with each other, but
+     * never with, or out of order relative to, the others.
+     *
+     * If accepting any value throws, the first exception is rethrown
+     * once the submitted tasks are done.
+     *
+     * @param[in] index The options
+     * @param[in] events The events to dispatch
+     * @param[in] executor The executor to run independent events on;
+     *                     if empty, everything is run in order on this thread
+     */
+    void dispatchEvents(const OptionIndex_& index,
+                        const std::vector<ParseEvent_>& events,
+                        const Executor& executor);
+
+    inline EventSink_::EventSink_(std::vector<ParseEvent_>& events,
+                                  std::vector<std::string_view>& rest)
+            : _events(events),
+              _rest(rest) {}
+
+    inline void EventSink_::match(std::size_t option, std::string_view value) {
+        _events.push_back({option, value});
+    }
+
+    inline void EventSink_::rest(std::string_view arg) {
+        _rest.push_back(arg);
+    }
+
+    inline EventBuffers_::Lease::Lease(EventBuffers_& buffers)
+            : _buffers(buffers),
+              _level(buffers.acquire()) {}
+
+    inline EventBuffers_::Lease::~Lease() {
+        --_buffers._depth;
+    }
+
+    inline std::vector<ParseEvent_>& EventBuffers_::Lease::events() const {
+        return _level.events;
+    }
+
+    inline std::vector<std::uint64_t>& EventBuffers_::Lease::used() const {
+        return _level.used;
+    }
+
+    inline EventBuffers_::Level& EventBuffers_::acquire() {
+        if (_depth == _levels.size()) {
+            _levels.emplace_back();
+        }
+        auto& level = _levels[_depth++];
+        level.events.clear();
+        return level;
+    }
+
+    inline EventBuffers_::EventBuffers_(const EventBuffers_&) {}
+
+    inline EventBuffers_& EventBuffers_::operator=(const EventBuffers_&) {
+        return *this;
+    }
+  }
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <tuple>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include <type_traits>
+
+#include "config.hpp"
+#include "utils.hpp"
+#include "ValueParser.hpp"
+#include "CallbackPolicy.hpp"
+#include "LazyValue.hpp"
+
+namespace info::parse::detail {
+  /**
+   * Thrown if supplied function callback
+   *  1) takes too many parameters
+   *  2)
+   */
+  class bad_function_callback : public virtual std::logic_error {
+  public:
+      bad_function_callback(int a);
+  };
+
+  /**
+   * Spits a parsed value back to the user of the library.
+   *
+   * Either writes into the exporter pointer, or calls the
+   * callback function with the value; converting the raw
+   * string value into whatever the target expects.
+   * Separated from Option_ so that anything which has found
+   * a value for an option can hand it over without having to
+   * know how the option is matched.
+   *
+   * @tparam T The type of the exporter to stuff the found value into,
+   *           or `none` if a callback is used
+   * @tparam R The return type of the callback function
+   * @tparam Args The parameters of the callback function
+   *
+   * @see Option_
+   */
+  template<class T = none,
+          class R = none, class... Args>
+  class Exporter_ {
+      /// Interface
+  public:
+      /**
+       * Converts the value as required by the exporter and
+       * puts it there, or calls the callback with it; as many
+       * times as the policy says.
+       *
+       * @param[in] value The raw value found for the option; only
+       *                  used during the call
+       * @param[in] policy How many times to call a callback
+       *
+       * @throws bad_function_callback If the callback takes too many
+       *                               parameters and config::FailSilently
+       *                               is not set.
+       */
+      void operator()(std::string_view value,
+                      const CallbackPolicy& policy = CallbackPolicy{}) const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the Exporter_ with a pointer
+       * to spit values into.
+       *
+       * @param[out] exporter The pointer to a constructed memory whereto
+       *                       dump the found value
+       *
+       * @note `exporter` is not checked for `nullptr`
+       */
+      Exporter_(T* exporter);
+
+      /**
+       * Constructs the Exporter_ with a callback function.
+       *
+       * @param[in] func The function callback to call with the found value
+       *
+       * @see Option_::Option_(OptionString, const std::function<R(Args...)>&)
+       */
+      Exporter_(const std::function<R(Args...)>& func);
+
+      /// Fields
+  private:
+      /// Exporter of type `T` whereto the parsed value will be spit back
+      T* _exporter;
+      /// Optional callback-function
+      std::optional<std::function<R(Args...)>> _callback;
+  };
+
+  template<class T, class R, class... Args>
+  inline Exporter_<T, R, Args...>::Exporter_(T* exporter)
+          : _exporter(exporter),
+            _callback(std::nullopt) {}
+
+  template<class T, class R, class... Args>
+  inline Exporter_<T, R, Args...>::Exporter_(const std::function<R(Args...)>& func)
+          : _exporter(nullptr),
+            _callback(func) {}
+
+  // Do not enter unless certified Template Templar
+  /****************************************************************************/
+  template<class, class...>
+  struct TypeD;
+
+  // Only named in decltype, never called
+  template<class T1>
+  std::tuple<TypeD<T1>*, int> mkTypeD(T1* v);
+
+  template<class T1, class... Args>
+  std::tuple<TypeD<T1, Args...>*, bool> mkTypeD(T1 (* f)(Args...));
+
+  template<class Fst = none, class...>
+  struct fP {
+      using Type = Fst;
+  };
+
+  template<class = none, class Snd = none, class...>
+  struct sP {
+      using Type = Snd;
+  };
+
+  template<class T, class R, class... Args>
+  void Exporter_<T, R, Args...>::operator()(std::string_view value,
+                                            const CallbackPolicy& policy) const {
+      if constexpr (std::is_same_v<T, none>) {
+          using Arg1 = std::remove_cv_t<std::remove_reference_t<typename fP<Args...>::Type>>;
+          using Arg2 = std::remove_cv_t<std::remove_reference_t<typename sP<Args...>::Type>>;
+
+          auto makeArg = [](std::string_view value) -> Arg1 {
+            if constexpr (std::is_same_v<Arg1, std::string>) {
+                // String is output directly
+                return std::string(value);
+            } else if constexpr (std::is_same_v<Arg1, std::string_view>) {
+                // View is output directly, without copying
+                return value;
+            } else {
+                Arg1 arg1{};
+                unless (value.empty()) {
+                    ValueParser<Arg1>::parse(value, arg1);
+                }
+                return arg1;
+            }
+          };
+
+          // returned pointers may be owned by the callback; exporter functions keep theirs
+          constexpr bool deletes = config::DeleteCallbackReturn;
+          // Give me switch constexpr pls
+          constexpr std::size_t args = sizeof...(Args);
+          if constexpr (args == 0) {
+              callWithPolicy<deletes>(policy, [&] { return (*_callback)(); });
+          } else if constexpr (args == 1) {
+              callWithPolicy<deletes>(policy, [&] { return (*_callback)(makeArg(value)); });
+          } else if constexpr (args == 2) {
+              if constexpr (std::is_same_v<Arg2, std::string>) {
+                  // exporter takes 2 values
+                  callWithPolicy<deletes>(policy, [&] { return (*_callback)(makeArg(value), std::string(value)); });
+              } else if constexpr (std::is_same_v<Arg2, std::string_view>) {
+                  callWithPolicy<deletes>(policy, [&] { return (*_callback)(makeArg(value), value); });
+              } else if constexpr (std::is_pointer_v<Arg2>) {
+                  // You asked for it
+                  callWithPolicy<deletes>(policy, [&] {
+                    std::string raw(value);
+                    return (*_callback)(makeArg(value), (Arg2) raw.c_str());
+                  });
+              } else // Hope this makes sense
+                  callWithPolicy<deletes>(policy, [&] { return (*_callback)(makeArg(value), Arg2{}); });
+          } else if (!config::FailSilently) {
+              throw bad_function_callback(sizeof...(Args));
+          }
+      } else {
+          using TDType = decltype(mkTypeD(_exporter));
+          using Typ =
+          typename std::remove_pointer_t<std::tuple_element_t<0, TDType>>;
+          using SecTyp = std::tuple_element_t<1, TDType>;
+
+          if constexpr (std::is_same_v<SecTyp, bool>) {
+              using Re = typename Typ::Ret;
+              using Arg1 = std::remove_cv_t<std::remove_reference_t<typename Typ::Arg0>>;
+              using Arg2 = std::remove_cv_t<std::remove_reference_t<typename Typ::Arg1>>;
+
+              auto callF = [&]() -> Re {
+                auto makeArg = [](std::string_view value) -> Arg1 {
+                  if constexpr (std::is_same_v<Arg1, std::string>) {
+                      // String is output directly
+                      return std::string(value);
+                  } else if constexpr (std::is_same_v<Arg1, std::string_view>) {
+                      // View is output directly, without copying
+                      return value;
+                  } else {
+                      Arg1 arg1{};
+                      unless (value.empty()) {
+                          ValueParser<Arg1>::parse(value, arg1);
+                      }
+                      return arg1;
+                  }
+                };
+
+                if constexpr (std::is_same_v<Arg1, none>) {
+                    // exporter takes no parameters
+                    return (*_exporter)();
+                } else if constexpr (std::is_same_v<Arg2, none>) {
+                    // exporter takes 1 parameter
+                    return (*_exporter)(makeArg(value));
+                } else if constexpr (std::is_same_v<std::remove_reference_t<std::remove_cv_t<Arg2>>,
+                        std::string>) {
+                    // exporter takes 2 values
+                    return (*_exporter)(makeArg(value), std::string(value));
+                } else if constexpr (std::is_same_v<Arg2, std::string_view>) {
+                    return (*_exporter)(makeArg(value), value);
+                } else if constexpr (std::is_pointer_v<Arg2>) {
+                    // You asked for it
+                    std::string raw(value);
+                    return (*_exporter)(makeArg(value), (Arg2) raw.c_str());
+                } else
+                    // Hope this makes sense
+                    return (*_exporter)(makeArg(value), Arg2{});
+              };
+
+              callWithPolicy(policy, callF);
+          } else if constexpr (is_lazy_value_v<T>) {
+              // Converted when first read
+              _exporter->set(value);
+          } else {
+              if (value.empty()) {
+                  *_exporter = T{};
+              } else {
+                  ValueParser<T>::parse(value, *_exporter);
+              }
+          }
+      }
+  }
+
+  template<class T1, class... Args>
+  struct TypeD {
+      typedef T1 Ret;
+
+      template<class Fst = none, class...>
+      struct fP {
+          using Type = Fst;
+      };
+
+      template<class = none, class Snd = none, class...>
+      struct sP {
+          using Type = Snd;
+      };
+
+      using Arg0 = typename fP<Args...>::Type;
+      using Arg1 = typename sP<Args...>::Type;
+
+      typedef T1 (* func)(Args...);
+
+      TypeD(func& f) {}
+
+      TypeD(T1*& val) {}
+  };
+  /****************************************************************************/
+}
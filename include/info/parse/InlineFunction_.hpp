@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+
+namespace info::parse::detail {
+  template<class Signature, std::size_t Size = 48>
+  class InlineFunction_;
+
+  /**
+   * A copyable callable wrapper, like std::function, which stores
+   * callables of up to Size bytes in itself instead of on the heap.
+   *
+   * Size is chosen so an Exporter_ fits, so an option's record holds
+   * its exporter directly: calling it is one indirect call on memory
+   * next to the record, instead of chasing a std::function's heap
+   * block, then the Exporter_'s own std::function.
+   * Larger callables are still accepted, and are stored on the heap.
+   *
+   * @tparam R The return type
+   * @tparam Args The parameters
+   * @tparam Size The bytes available for storing the callable inline
+   */
+  template<class R, class... Args, std::size_t Size>
+  class InlineFunction_<R(Args...), Size> {
+      /// Interface
+  public:
+      /**
+       * Calls the stored callable; must not be empty
+       */
+      R operator()(Args... args) const;
+
+      /**
+       * Whether a callable is stored
+       */
+      _retpure explicit operator bool() const noexcept;
+
+      /// Lifecycle
+  public:
+      InlineFunction_() noexcept = default;
+
+      /**
+       * Stores a copy of the callable
+       *
+       * @param[in] f The callable to store
+       */
+      template<class F, class = std::enable_if_t<
+              !std::is_same_v<std::decay_t<F>, InlineFunction_>
+              && std::is_invocable_r_v<R, const std::decay_t<F>&, Args...>>>
+      InlineFunction_(F&& f);
+
+      InlineFunction_(const InlineFunction_& cp);
+      InlineFunction_(InlineFunction_&& mv) noexcept;
+      InlineFunction_& operator=(const InlineFunction_& cp);
+      InlineFunction_& operator=(InlineFunction_&& mv) noexcept;
+      ~InlineFunction_();
+
+      /// Fields
+  private:
+      enum class Op {
+          Copy, Move, Destroy
+      };
+
+      /// Calls the callable stored in the buffer
+      R (* _invoke)(const void*, Args&& ...) = nullptr;
+      /// Copies, moves or destroys the callable stored in the buffer
+      void (* _manage)(Op, void*, void*) = nullptr;
+      /// The callable, or a pointer to it if it is too large
+      alignas(std::max_align_t) unsigned char _buffer[Size];
+
+      /// Methods
+  private:
+      template<class F>
+      static constexpr bool fitsInline = sizeof(F) <= Size
+                                         && alignof(std::max_align_t) % alignof(F) == 0
+                                         && std::is_nothrow_move_constructible_v<F>;
+
+      void assign(const InlineFunction_& cp);
+
+      void take(InlineFunction_& mv) noexcept;
+
+      void clear() noexcept;
+  };
+
+  template<class R, class... Args, std::size_t Size>
+  template<class F, class>
+  InlineFunction_<R(Args...), Size>::InlineFunction_(F&& f) {
+      using Fn = std::decay_t<F>;
+      if constexpr (fitsInline<Fn>) {
+          ::new(static_cast<void*>(_buffer)) Fn(std::forward<F>(f));
+          _invoke = [](const void* buf, Args&& ... args) -> R {
+            return (*static_cast<const Fn*>(buf))(std::forward<Args>(args)...);
+          };
+          _manage = [](Op op, void* self, void* other) {
+            auto fn = static_cast<Fn*>(self);
+            switch (op) {
+                case Op::Copy:
+                    ::new(other) Fn(*fn);
+                    break;
+                case Op::Move:
+                    ::new(other) Fn(std::move(*fn));
+                    fn->~Fn();
+                    break;
+                case Op::Destroy:
+                    fn->~Fn();
+                    break;
+            }
+          };
+      } else {
+          ::new(static_cast<void*>(_buffer)) Fn*(new Fn(std::forward<F>(f)));
+          _invoke = [](const void* buf, Args&& ... args) -> R {
+            return (**static_cast<Fn* const*>(buf))(std::forward<Args>(args)...);
+          };
+          _manage = [](Op op, void* self, void* other) {
+            auto fn = static_cast<Fn**>(self);
+            switch (op) {
+                case Op::Copy:
+                    ::new(other) Fn*(new Fn(**fn));
+                    break;
+                case Op::Move:
+                    ::new(other) Fn*(*fn);
+                    break;
+                case Op::Destroy:
+                    delete *fn;
+                    break;
+            }
+          };
+      }
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  inline R InlineFunction_<R(Args...), Size>::operator()(Args... args) const {
+      return _invoke(_buffer, std::forward<Args>(args)...);
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  inline InlineFunction_<R(Args...), Size>::operator bool() const noexcept {
+      return _invoke != nullptr;
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  InlineFunction_<R(Args...), Size>::InlineFunction_(const InlineFunction_& cp) {
+      assign(cp);
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  InlineFunction_<R(Args...), Size>::InlineFunction_(InlineFunction_&& mv) noexcept {
+      take(mv);
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  InlineFunction_<R(Args...), Size>&
+  InlineFunction_<R(Args...), Size>::operator=(const InlineFunction_& cp) {
+      if (this != &cp) {
+          InlineFunction_ copy(cp);
+          clear();
+          take(copy);
+      }
+      return *this;
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  InlineFunction_<R(Args...), Size>&
+  InlineFunction_<R(Args...), Size>::operator=(InlineFunction_&& mv) noexcept {
+      if (this != &mv) {
+          clear();
+          take(mv);
+      }
+      return *this;
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  InlineFunction_<R(Args...), Size>::~InlineFunction_() {
+      clear();
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  void InlineFunction_<R(Args...), Size>::assign(const InlineFunction_& cp) {
+      if (cp._manage) {
+          cp._manage(Op::Copy, const_cast<unsigned char*>(cp._buffer), _buffer);
+      }
+      _invoke = cp._invoke;
+      _manage = cp._manage;
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  void InlineFunction_<R(Args...), Size>::take(InlineFunction_& mv) noexcept {
+      if (mv._manage) {
+          mv._manage(Op::Move, mv._buffer, _buffer);
+      }
+      _invoke = std::exchange(mv._invoke, nullptr);
+      _manage = std::exchange(mv._manage, nullptr);
+  }
+
+  template<class R, class... Args, std::size_t Size>
+  void InlineFunction_<R(Args...), Size>::clear() noexcept {
+      if (_manage) {
+          _manage(Op::Destroy, _buffer, nullptr);
+      }
+      _invoke = nullptr;
+      _manage = nullptr;
+  }
+}
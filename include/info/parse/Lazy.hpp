@@ -4,9 +4,15 @@
 
 #pragma once
 
+#include <new>
+#include <atomic>
+#include <thread>
+#include <utility>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <exception>
+#include <type_traits>
 
 #include "utils.hpp"
 
@@ -45,6 +51,9 @@ namespace info::parse::detail {
    * whenever the value is first requested. If never
    * requested it will never be instantiated.
    *
+   * Not thread-safe; see InlineLazy for one that is, and does
+   * not allocate.
+   *
    * @tparam T Type to instantiate
    * @tparam TArgs Arguments with which T is instantiated
    */
@@ -69,6 +78,12 @@ namespace info::parse::detail {
        */
       _retpure bool isInited() const;
 
+      /**
+       * Forgets the instance, so the next request
+       * instantiates it again
+       */
+      void reset();
+
       /**
        * Implicit casts object to type T if plausible:
        *  - type T is already constructed; or
@@ -156,6 +171,12 @@ namespace info::parse::detail {
       return inited;
   }
 
+  template<class T, class... TArgs>
+  inline void Lazy<T, TArgs...>::reset() {
+      inited = false;
+      val.reset();
+  }
+
   template<class T, class... TArgs>
   inline const T& Lazy<T, TArgs...>::get(TArgs... args) const {
       if (!inited) {
@@ -199,4 +220,274 @@ namespace info::parse::detail {
       }
   }
 
+
+  /**
+   * A Lazy which stores the instance inline instead of on the heap,
+   * and the initializer as an object of the type given, instead of in
+   * an std::function.
+   *
+   * The first instantiation is thread-safe: if multiple threads request
+   * the value at once, one of them calls the initializer, while the others
+   * wait for it to finish. If the initializer throws, the next request calls
+   * it again. Once instantiated, reading the value is one atomic load.
+   * reset() and assignment are not thread-safe.
+   *
+   * Assignment replaces the initializer too, by constructing it anew,
+   * so initializers which cannot be assigned, like lambdas, can be.
+   * If that construction throws, the object is left without an
+   * initializer, and get() throws std::bad_optional_access.
+   *
+   * The initializer returns T, or anything T is constructible from; or,
+   * like the ones Lazy takes, a pointer to T, which is then dereferenced
+   * and moved from.
+   *
+   * @code
+   * auto lazy = makeLazy<Searcher, std::string_view>([](std::string_view name) {
+   *   return Searcher(name);
+   * });
+   * @endcode
+   *
+   * @tparam T Type to instantiate
+   * @tparam Init The type of the initializer
+   * @tparam TArgs Arguments with which T is instantiated
+   */
+  template<class T,
+          class Init,
+          class... TArgs>
+  class InlineLazy {
+      /// Interface
+  public:
+      /**
+       * @copydoc Lazy::get
+       */
+      _retval const T& get(TArgs... args) const;
+
+      /**
+       * @copydoc Lazy::isInited
+       */
+      _retval bool isInited() const;
+
+      /**
+       * @copydoc Lazy::reset
+       */
+      void reset();
+
+      /**
+       * @copydoc Lazy::operator const T&
+       */
+      _retval operator const T&() const;
+
+      /**
+       * @copydoc Lazy::operator*
+       */
+      _retval const T& operator*() const;
+
+      /**
+       * @copydoc Lazy::operator->
+       */
+      _retval const T* operator->() const;
+
+      /**
+       * @copydoc Lazy::operator()
+       */
+      _retval const T& operator()(TArgs... args) const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the object by storing the initializer
+       *
+       * @param[in] initer The function to instantiate and initialize
+       *                the instance of type T whenever requested
+       */
+      explicit InlineLazy(Init initer = Init());
+
+      InlineLazy(const InlineLazy& other);
+      InlineLazy(InlineLazy&& other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                              && std::is_nothrow_move_constructible_v<Init>);
+
+      InlineLazy& operator=(const InlineLazy& other);
+      InlineLazy& operator=(InlineLazy&& other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                                         && std::is_nothrow_move_constructible_v<Init>);
+
+      ~InlineLazy();
+
+      /// Fields
+  private:
+      enum State : unsigned char {
+          empty,
+          building,
+          ready
+      };
+
+      /// Function to initialize the instance; only empty if
+      /// constructing it in an assignment threw
+      std::optional<Init> initer;
+      /// The storage of the instance
+      alignas(T) mutable unsigned char storage[sizeof(T)];
+      /// Whether the instance is built, or being built
+      mutable std::atomic<unsigned char> state{empty};
+
+      /// Methods
+  private:
+      _retpure const T& value() const;
+
+      void build(TArgs... args) const;
+  };
+
+  /**
+   * Makes an InlineLazy, deducing the type of the initializer
+   *
+   * @tparam T Type to instantiate
+   * @tparam TArgs Arguments with which T is instantiated
+   * @param[in] initer The function to instantiate and initialize
+   *                the instance of type T whenever requested
+   */
+  template<class T, class... TArgs, class Init>
+  _retval InlineLazy<T, Init, TArgs...> makeLazy(Init initer) {
+      return InlineLazy<T, Init, TArgs...>(std::move(initer));
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>::InlineLazy(Init initer)
+          : initer(std::move(initer)) {}
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>::InlineLazy(const InlineLazy& other)
+          : initer(other.initer) {
+      if (other.isInited()) {
+          new(storage) T(other.value());
+          state.store(ready, std::memory_order_relaxed);
+      }
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>::InlineLazy(InlineLazy&& other)
+  noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<Init>)
+          : initer(std::move(other.initer)) {
+      if (other.isInited()) {
+          new(storage) T(std::move(const_cast<T&>(other.value())));
+          state.store(ready, std::memory_order_relaxed);
+      }
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>&
+  InlineLazy<T, Init, TArgs...>::operator=(const InlineLazy& other) {
+      if (this != &other) {
+          reset();
+          initer.reset();
+          if (other.initer) {
+              initer.emplace(*other.initer);
+          }
+          if (other.isInited()) {
+              new(storage) T(other.value());
+              state.store(ready, std::memory_order_release);
+          }
+      }
+      return *this;
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>&
+  InlineLazy<T, Init, TArgs...>::operator=(InlineLazy&& other)
+  noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<Init>) {
+      if (this != &other) {
+          reset();
+          initer.reset();
+          if (other.initer) {
+              initer.emplace(std::move(*other.initer));
+          }
+          if (other.isInited()) {
+              new(storage) T(std::move(const_cast<T&>(other.value())));
+              state.store(ready, std::memory_order_release);
+          }
+      }
+      return *this;
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>::~InlineLazy() {
+      reset();
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline bool InlineLazy<T, Init, TArgs...>::isInited() const {
+      return state.load(std::memory_order_acquire) == ready;
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline void InlineLazy<T, Init, TArgs...>::reset() {
+      if (state.load(std::memory_order_relaxed) == ready) {
+          value().~T();
+          state.store(empty, std::memory_order_relaxed);
+      }
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline const T& InlineLazy<T, Init, TArgs...>::get(TArgs... args) const {
+      unless (isInited()) {
+          build(args...);
+      }
+      return value();
+  }
+
+  template<class T, class Init, class... TArgs>
+  void InlineLazy<T, Init, TArgs...>::build(TArgs... args) const {
+      unsigned char expected = empty;
+      until (state.compare_exchange_weak(expected, building,
+                                         std::memory_order_acquire, std::memory_order_acquire)) {
+          if (expected == ready)
+              return;
+          if (expected == building)
+              std::this_thread::yield();
+          expected = empty;
+      }
+
+      try {
+          auto& init = initer.value();
+          using Result = decltype(init(args...));
+          if constexpr (std::is_constructible_v<T, Result>) {
+              new(storage) T(init(args...));
+          } else {
+              new(storage) T(std::move(*init(args...)));
+          }
+      } catch (...) {
+          state.store(empty, std::memory_order_release);
+          throw;
+      }
+      state.store(ready, std::memory_order_release);
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline const T& InlineLazy<T, Init, TArgs...>::value() const {
+      return *std::launder(reinterpret_cast<const T*>(storage));
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline InlineLazy<T, Init, TArgs...>::operator const T&() const {
+      return **this;
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline const T& InlineLazy<T, Init, TArgs...>::operator*() const {
+      if (isInited()) {
+          return value();
+      }
+      if constexpr (sizeof...(TArgs) == 0) {
+          return get();
+      } else {
+          throw bad_lazy_eval(typeid(T).name());
+      }
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline const T& InlineLazy<T, Init, TArgs...>::operator()(TArgs... args) const {
+      return get(args...);
+  }
+
+  template<class T, class Init, class... TArgs>
+  inline const T* InlineLazy<T, Init, TArgs...>::operator->() const {
+      return &**this;
+  }
 }
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "Lazy.hpp"
+#include "ValueParser.hpp"
+
+namespace info::parse {
+  /**
+   * A variable for an option whose value is converted the first time
+   * it is read, instead of while parsing.
+   *
+   * Parsing only keeps the raw value found; so options that are never
+   * read cost no conversion at all, which pays off with many options
+   * of types that are costly to convert. Reading the value converts it
+   * once with ValueParser<T>, the same as a plain variable would have
+   * been; reading again returns the same object. If the option was not
+   * found, the initial value is read. A value found by a later parse
+   * replaces the earlier one, and is converted again when read.
+   *
+   * Reading from multiple threads at once is safe, and converts the value
+   * once; parsing into it while it is read is not.
+   *
+   * @code
+   * info::parse::LazyValue<Schema> schema;
+   * parser.addOption("schema|s", &schema);
+   * parser.parse(argc, argv);
+   * if (validating) {
+   *     validate(*schema); // converted here, if ever
+   * }
+   * @endcode
+   *
+   * @tparam T The type of the value; default constructible
+   *           and convertible by ValueParser
+   */
+  template<class T>
+  class LazyValue {
+      /// Interface
+  public:
+      /**
+       * Returns the value, converting it if not yet converted
+       *
+       * @return The value found, or the initial value if none was found
+       */
+      _retval const T& get() const;
+
+      /**
+       * Returns whether a value was found for the option
+       */
+      _retpure bool isSet() const;
+
+      /**
+       * Returns whether the value found was already converted
+       */
+      _retpure bool isConverted() const;
+
+      /**
+       * Returns the raw value found, as it was in the arguments
+       */
+      _retpure std::string_view raw() const;
+
+      /**
+       * Stores the raw value found, to be converted when read.
+       * Called by the parser.
+       *
+       * @param[in] value The raw value; copied
+       */
+      void set(std::string_view value);
+
+      /**
+       * The value, converted if not yet converted
+       *
+       * @see get()
+       */
+      _retpure operator const T&() const;
+
+      _retpure const T& operator*() const;
+
+      _retpure const T* operator->() const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the value, with the initial value to read
+       * if the option is not found
+       *
+       * @param[in] initial The value if the option is not found
+       */
+      LazyValue(T initial = T{});
+
+      /// Fields
+  private:
+      /// The raw value found
+      std::string _raw;
+      /// Whether a value was found
+      bool _set = false;
+      /// The value read if none was found
+      T _initial;
+      /// Converts the raw value with ValueParser<T>
+      struct Convert {
+          T operator()(std::string_view raw) const;
+      };
+
+      /// The value converted from _raw
+      detail::InlineLazy<T, Convert, std::string_view> _value;
+  };
+
+  /**
+   * LazyValues take any value, and convert it only when read
+   */
+  template<class T>
+  struct ValueParser<LazyValue<T>> {
+      static bool parse(std::string_view value, LazyValue<T>& out) {
+          out.set(value);
+          return true;
+      }
+  };
+
+  namespace detail {
+    /**
+     * Whether T is a LazyValue
+     */
+    template<class T>
+    inline constexpr bool is_lazy_value_v = false;
+
+    template<class T>
+    inline constexpr bool is_lazy_value_v<LazyValue<T>> = true;
+
+    /**
+     * Whether options exporting into T are boolean flags
+     */
+    template<class T>
+    inline constexpr bool is_flag_v = std::is_same_v<T, bool>
+                                      || std::is_same_v<T, LazyValue<bool>>;
+  }
+
+  template<class T>
+  inline LazyValue<T>::LazyValue(T initial)
+          : _initial(std::move(initial)) {}
+
+  template<class T>
+  inline T LazyValue<T>::Convert::operator()(std::string_view raw) const {
+      T value{};
+      unless (raw.empty()) {
+          detail::parseValue(raw, value);
+      }
+      return value;
+  }
+
+  template<class T>
+  inline const T& LazyValue<T>::get() const {
+      unless (_set) {
+          return _initial;
+      }
+      return _value.get(_raw);
+  }
+
+  template<class T>
+  inline bool LazyValue<T>::isSet() const {
+      return _set;
+  }
+
+  template<class T>
+  inline bool LazyValue<T>::isConverted() const {
+      return _set && _value.isInited();
+  }
+
+  template<class T>
+  inline std::string_view LazyValue<T>::raw() const {
+      return _raw;
+  }
+
+  template<class T>
+  inline void LazyValue<T>::set(std::string_view value) {
+      _raw.assign(value.data(), value.size());
+      _set = true;
+      _value.reset();
+  }
+
+  template<class T>
+  inline LazyValue<T>::operator const T&() const {
+      return get();
+  }
+
+  template<class T>
+  inline const T& LazyValue<T>::operator*() const {
+      return get();
+  }
+
+  template<class T>
+  inline const T* LazyValue<T>::operator->() const {
+      return &get();
+  }
+}
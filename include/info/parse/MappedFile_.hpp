@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "utils.hpp"
+
+namespace info::parse::detail {
+  /**
+   * The read-only contents of a file, memory-mapped where possible
+   * and read whole otherwise; or memory given by the caller.
+   *
+   * Files which claim to be empty, like the ones in `/proc`, are
+   * read instead of mapped, as their size is only known once read.
+   * The contents stay where they are when the object is moved.
+   */
+  class MappedFile_ {
+      /// Interface
+  public:
+      /**
+       * Returns the contents
+       */
+      _retpure std::string_view data() const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Maps the file into memory
+       *
+       * @param[in] path The path of the file
+       * @throws std::system_error if the file cannot be opened, read or mapped
+       */
+      explicit MappedFile_(const std::string& path);
+
+      /**
+       * Refers to memory already there, without copying it
+       *
+       * @param[in] data The memory; has to outlive the object
+       */
+      _retval static MappedFile_ view(std::string_view data);
+
+      /**
+       * Keeps a copy of the memory, aligned for any fundamental type
+       *
+       * @param[in] data The memory to copy
+       */
+      _retval static MappedFile_ copy(std::string_view data);
+
+      MappedFile_(const MappedFile_&) = delete;
+      MappedFile_& operator=(const MappedFile_&) = delete;
+
+      MappedFile_(MappedFile_&& other) noexcept;
+      MappedFile_& operator=(MappedFile_&& other) noexcept;
+
+      ~MappedFile_();
+
+      /// Fields
+  private:
+      /// The contents
+      std::string_view _data;
+      /// The start of the mapping, if the file is mapped
+      void* _mapping = nullptr;
+      /// The contents, if read or copied; on the heap, so they
+      /// stay put when moved
+      std::unique_ptr<char[]> _buffer;
+
+      /// Methods
+  private:
+      MappedFile_() = default;
+
+      void assign(std::string_view data);
+
+      void release() noexcept;
+  };
+
+  inline std::string_view MappedFile_::data() const {
+      return _data;
+  }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+
+#include "utils.hpp"
+
+namespace info::parse::detail {
+  /**
+   * The names of an option, as views of text stored elsewhere,
+   * like in the block of an OptionString.
+   *
+   * Iterating, indexing and copying it neither copies nor
+   * allocates anything; the names stay where they are for the
+   * lifetime of their storage.
+   */
+  class NameView {
+      /// Interface
+  public:
+      typedef const std::string_view* const_iterator;
+      typedef const_iterator iterator;
+      typedef std::size_t size_type;
+
+      _retpure const_iterator begin() const;
+      _retpure const_iterator end() const;
+
+      _retpure size_type size() const;
+      _retpure bool empty() const;
+
+      /**
+       * Returns the i-th name, without checking i
+       */
+      _retpure std::string_view operator[](size_type i) const;
+
+      /**
+       * Returns the i-th name
+       *
+       * @throws std::out_of_range if there are not that many names
+       */
+      _retpure std::string_view at(size_type i) const;
+
+      /// Lifecycle
+  public:
+      NameView() = default;
+      NameView(const std::string_view* first, size_type size);
+
+      /// Fields
+  private:
+      /// The first name
+      const std::string_view* _first = nullptr;
+      /// The amount of names
+      size_type _size = 0;
+  };
+
+  /**
+   * Append-only storage of the option names of an OptionIndex_,
+   * which never moves what it stores.
+   *
+   * The text is kept in chunks of a few kilobytes each, and is
+   * interned: storing the same text again returns what was stored
+   * the first time. The arena is owned by the index, and shared by
+   * its copies, as their names view it; it is freed with the last
+   * of them.
+   *
+   * Storing is synchronized, as copies of an index may store names
+   * from different threads; reading what was stored needs no
+   * synchronization, as it is never changed.
+   */
+  class NameArena_ {
+      /// Interface
+  public:
+      /**
+       * Stores a text as it is
+       *
+       * @param[in] text The text to store
+       * @return The text stored
+       */
+      _retval std::string_view store(std::string_view text);
+
+      /// Lifecycle
+  public:
+      NameArena_() = default;
+
+      NameArena_(const NameArena_&) = delete;
+      NameArena_& operator=(const NameArena_&) = delete;
+
+      /// Fields
+  private:
+      /// The size of the chunks, except of the ones made for
+      /// something larger
+      static constexpr std::size_t chunkSize = 4096;
+
+      /// Guards everything below
+      std::mutex _mutex;
+      /// The memory everything is stored in
+      std::vector<std::unique_ptr<char[]>> _chunks;
+      /// The free part of the last chunk
+      char* _free = nullptr;
+      /// The size of the free part of the last chunk
+      std::size_t _left = 0;
+      /// The texts stored
+      std::unordered_set<std::string_view> _texts;
+
+      /// Methods
+  private:
+      _retval char* allocate(std::size_t size, std::size_t alignment);
+  };
+
+  inline NameView::NameView(const std::string_view* first, size_type size)
+          : _first(first),
+            _size(size) {}
+
+  inline NameView::const_iterator NameView::begin() const {
+      return _first;
+  }
+
+  inline NameView::const_iterator NameView::end() const {
+      return _first + _size;
+  }
+
+  inline NameView::size_type NameView::size() const {
+      return _size;
+  }
+
+  inline bool NameView::empty() const {
+      return _size == 0;
+  }
+
+  inline std::string_view NameView::operator[](size_type i) const {
+      return _first[i];
+  }
+
+  inline std::string_view NameView::at(size_type i) const {
+      unless (i < _size) {
+          throw std::out_of_range("No name at " + std::to_string(i));
+      }
+      return _first[i];
+  }
+}
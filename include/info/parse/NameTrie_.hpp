@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+
+#include "utils.hpp"
+
+namespace info::parse::detail {
+  /**
+   * A trie built from the names of all options, with the edges
+   * of each state sorted by character.
+   *
+   * Walking it from the root with step() looks up a name, or the
+   * longest name that is a prefix of an argument, in one pass over
+   * the argument, instead of comparing it with each name.
+   *
+   * Each name has one or more owners; the indices of the options
+   * which registered it in registration order.
+   * The trie is stored in flat arrays of offsets, without pointers,
+   * so it is cheap to copy, and can be saved into an image which is
+   * then used in place, without building anything, by attach().
+   */
+  class NameTrie_ {
+      /// Interface
+  public:
+      /// The state in which nothing has been read
+      static constexpr std::uint32_t root = 0;
+      /// The state returned by step if there is no transition
+      static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+      /**
+       * Builds the trie from the names and their owners,
+       * dropping whatever has been built before.
+       *
+       * @param[in] names The names paired with their owner in
+       *                  registration order
+       */
+      void build(const std::vector<std::pair<std::string_view, std::size_t>>& names);
+
+      /**
+       * Follows the transition of the trie from the state on
+       * the character.
+       *
+       * @param[in] state The state to move from
+       * @param[in] c The character read
+       * @return The state moved into, or none
+       */
+      _retpure std::uint32_t step(std::uint32_t state, char c) const;
+
+      /**
+       * Returns the owners of the name ending in the state.
+       *
+       * @param[in] state The state
+       * @return A pair of pointers delimiting the owners of the
+       *          name; empty if no name ends there
+       */
+      _retpure std::pair<const std::uint32_t*, const std::uint32_t*>
+      owners(std::uint32_t state) const;
+
+      /**
+       * Appends the arrays of the trie to the image, with the
+       * layout attach() reads them in.
+       *
+       * @param[out] image The image to append to; its size has to be
+       *             a multiple of 4, and stays one
+       */
+      void save(std::string& image) const;
+
+      /**
+       * Uses the arrays saved into the image in place, dropping
+       * whatever has been built before. The image is checked to be
+       * whole, and to never lead out of the arrays.
+       *
+       * @param[in] image The image, starting where save() appended the
+       *            arrays; 4-aligned, and outliving the trie and its copies
+       * @param[in] owners The amount of options; every owner has to be less,
+       *            and there may be no more options than owners
+       * @return The size of the arrays in the image
+       * @throws std::invalid_argument if the image is truncated or malformed
+       */
+      std::size_t attach(std::string_view image, std::size_t owners);
+
+      /**
+       * Collects all names with their owners, in the order of the trie.
+       *
+       * @param[out] names The names and owners are appended here
+       */
+      void names(std::vector<std::pair<std::string, std::size_t>>& names) const;
+
+      /// Lifecycle
+  public:
+      NameTrie_();
+
+      NameTrie_(const NameTrie_& other);
+      NameTrie_& operator=(const NameTrie_& other);
+
+      NameTrie_(NameTrie_&& other) noexcept;
+      NameTrie_& operator=(NameTrie_&& other) noexcept;
+
+      /// Fields
+  private:
+      struct State {
+          /// The transitions of the state, as a range of _edges
+          std::uint32_t firstEdge, edgeCount;
+          /// The owners of the name ending here, as a range of _owners
+          std::uint32_t firstOwner, ownerCount;
+          /// The length of the string read to get here
+          std::uint32_t depth;
+      };
+
+      struct Edge {
+          char c;
+          std::uint32_t target;
+      };
+
+      /// The states, with the root being the first
+      std::vector<State> _states{State{0, 0, 0, 0, 0}};
+      /// The transitions of all states, sorted by character for each state
+      std::vector<Edge> _edges;
+      /// The owners of all names
+      std::vector<std::uint32_t> _owners;
+
+      /// The arrays used: the ones above, or the ones of an image
+      const State* _stateData;
+      const Edge* _edgeData;
+      const std::uint32_t* _ownerData;
+      std::uint32_t _stateCount, _edgeCount, _ownerCount;
+
+      /// Methods
+  private:
+      /// Uses the arrays of this object
+      void own();
+  };
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "utils.hpp"
+#include "MappedFile_.hpp"
+#include "OptionIndex_.hpp"
+
+namespace info::parse {
+  class OptionsParser;
+
+  /**
+   * The names of a fixed set of options, compiled once into a binary
+   * image, which later processes map into memory and parse with as it
+   * is, without splitting or indexing any name.
+   *
+   * The image holds the trie the names are looked up with, in flat
+   * arrays of offsets, so it can be mapped at any address. It is made for
+   * the machine it is made on: loading it on one with a different byte
+   * order, or with a different signedness of `char`, fails. Options are
+   * identified by their position in build(), as with makeOptionTable();
+   * an OptionsParser made from the image binds them to variables or
+   * callbacks by that position, and only parses the ones bound.
+   *
+   * @code
+   * // at build time
+   * std::ofstream("tool.opts", std::ios::binary)
+   *       << info::parse::OptionImage::build({"silent|quiet|s|q", "output|o"});
+   * // at startup
+   * info::parse::OptionImage image("tool.opts");
+   * info::parse::OptionsParser parser(image);
+   * parser.addOption(image.option("silent"), &silent)
+   *       .addOption(image.option("o"), &output);
+   * @endcode
+   */
+  class OptionImage {
+      /// Interface
+  public:
+      /**
+       * Makes the image of the options
+       *
+       * @param[in] options The names of each option, in the format
+       *            OptionsParser::addOption() takes them
+       * @return The image
+       * @throws std::invalid_argument if an option has no names
+       */
+      _retval static std::string build(const std::vector<std::string>& options);
+
+      /**
+       * Looks up the option a name belongs to
+       *
+       * @param[in] name Any name of the option, without dashes
+       * @return The position of the option in build()
+       * @throws std::out_of_range if no option has the name
+       */
+      _retpure std::size_t option(std::string_view name) const;
+
+      /**
+       * Returns the amount of options in the image
+       */
+      _retpure std::size_t size() const;
+
+      /**
+       * Returns the bytes of the image
+       */
+      _retpure std::string_view data() const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Maps the image file into memory, and checks it
+       *
+       * @param[in] path The path of the file made from build()
+       * @throws std::system_error if the file cannot be opened or mapped
+       * @throws std::invalid_argument if it is not an image of this
+       *         version made on this kind of machine, or is malformed
+       */
+      explicit OptionImage(const std::string& path);
+
+      /**
+       * Uses an image already in memory, and checks it. It is copied
+       * if not aligned to 4 bytes, used in place otherwise.
+       *
+       * @param[in] image The image; has to outlive the object
+       * @throws std::invalid_argument if it is not an image of this
+       *         version made on this kind of machine, or is malformed
+       */
+      _retval static OptionImage inMemory(std::string_view image);
+
+      /// Fields
+  private:
+      friend class OptionsParser;
+
+      /// The bytes
+      detail::MappedFile_ _file;
+      /// The options, using the bytes in place
+      detail::OptionIndex_ _index;
+
+      /// Methods
+  private:
+      explicit OptionImage(detail::MappedFile_ file);
+  };
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <utility>
+#include <string_view>
+
+#include "utils.hpp"
+#include "CallbackPolicy.hpp"
+#include "InlineFunction_.hpp"
+#include "NameArena_.hpp"
+#include "NameTrie_.hpp"
+#include "OptionString.hpp"
+
+namespace info::parse::detail {
+  /**
+   * One option as known by the OptionIndex_.
+   *
+   * Stores everything required to hand a found value to
+   * the option, without knowing the type the option
+   * exports to.
+   */
+  struct OptionRecord_ {
+      /// Whether the option is a boolean flag, or takes a value
+      bool flag;
+      /// Spits the found raw value back to the option's exporter;
+      /// the exporter is stored in the record itself
+      InlineFunction_<void(std::string_view, const CallbackPolicy&)> exporter;
+      /// Whether accepting can run in parallel with other
+      /// independent options
+      bool independent = false;
+      /// How many times the option's callback is called
+      CallbackPolicy policy{};
+
+      /**
+       * Hands the found value to the exporter, as the policy says
+       *
+       * @param[in] value The raw value found for the option
+       */
+      void accept(std::string_view value) const {
+          exporter(value, policy);
+      }
+  };
+
+  /**
+   * Indexes all names of all options registered
+   * into an OptionsParser, so an argument can be resolved
+   * to the option it names without trying every option
+   * one after the other.
+   *
+   * Names are stored as they are in the OptionString, that
+   * is with one prepended dash, so the argument `--alpha` is
+   * looked up as `-alpha`, while `-a` is looked up as is.
+   * They are copied into a NameArena_ of the index, which its
+   * copies share, and which goes away with the last of them.
+   *
+   * The names are compiled into one NameTrie_ when the index
+   * is frozen, which happens before parsing, and is only redone if
+   * options were added since. Looking up anything requires the
+   * index to be frozen.
+   *
+   * @see ParseSession_
+   */
+  class OptionIndex_ {
+      /// Interface
+  public:
+      /// The value returned by find if nothing is found
+      static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+      /**
+       * Adds an option to the index under all its names.
+       * If a name is already taken by an earlier option, the earlier
+       * option keeps it.
+       *
+       * @param[in] names The names of the option
+       * @param[in] flag Whether the option is a boolean flag
+       * @param[in] accept The function to hand the found values to
+       */
+      void addOption(const OptionString& names, bool flag,
+                     InlineFunction_<void(std::string_view, const CallbackPolicy&)> accept);
+
+      /**
+       * Marks the option as independent of all other options,
+       * so its values may be accepted in parallel with the values
+       * of other independent options.
+       *
+       * @param[in] option The index of the option
+       * @throws std::out_of_range if there is no such option
+       */
+      void markIndependent(std::size_t option);
+
+      /**
+       * Sets how many times the option's callback is called.
+       *
+       * @param[in] option The index of the option
+       * @param[in] policy The policy to call the callback by
+       * @throws std::out_of_range if there is no such option
+       */
+      void setPolicy(std::size_t option, CallbackPolicy policy);
+
+      /**
+       * Replaces what the option does with its values.
+       *
+       * @param[in] option The index of the option
+       * @param[in] flag Whether the option is a boolean flag
+       * @param[in] accept The function to hand the found values to
+       * @throws std::out_of_range if there is no such option
+       */
+      void bind(std::size_t option, bool flag,
+                InlineFunction_<void(std::string_view, const CallbackPolicy&)> accept);
+
+      /**
+       * Builds the trie of the names, if options have been
+       * added since it was last built.
+       */
+      void freeze();
+
+      /**
+       * Appends the image of the index to the string: the amount of
+       * options and the trie of their names, without the records.
+       * The index has to be frozen.
+       *
+       * @param[out] image The string to append to; empty, or the size
+       *             of it a multiple of 4
+       */
+      void save(std::string& image) const;
+
+      /**
+       * Replaces the index with the one in the image, used in place.
+       * Its options are not bound to anything, so they are not found
+       * until bound; adding an option copies the names out of the image.
+       *
+       * @param[in] image An image made by save(), 4-aligned, outliving
+       *            the index and its copies
+       * @throws std::invalid_argument if the image is not one save()
+       *         made on the same kind of machine, or is malformed
+       */
+      void attach(std::string_view image);
+
+      /**
+       * Looks up the option registered with the exact name.
+       *
+       * @param[in] name The name with one leading dash, like `-alpha`
+       * @return The index of the option's record, or npos
+       */
+      _retpure std::size_t find(std::string_view name) const;
+
+      /**
+       * Looks up the option registered with the exact name,
+       * whether it is bound or not.
+       *
+       * @param[in] name The name with one leading dash, like `-alpha`
+       * @return The index of the option's record, or npos
+       */
+      _retpure std::size_t owner(std::string_view name) const;
+
+      /**
+       * Looks up the option registered with the name made of the
+       * prefix and the rest, whether it is bound or not, without
+       * concatenating them.
+       *
+       * @param[in] prefix The start of the name, like `-`
+       * @param[in] rest The rest of the name, like `alpha`
+       * @return The index of the option's record, or npos
+       */
+      _retpure std::size_t owner(std::string_view prefix, std::string_view rest) const;
+
+      /**
+       * Looks up the value taking option whose name is the longest
+       * proper prefix of the supplied string. Used for values glued
+       * to the option's name like `--textAbsorption`.
+       * The argument is walked once, regardless of the names' lengths.
+       *
+       * @param[in] arg The argument with one leading dash stripped
+       * @return The index of the option's record, or npos; and the
+       *          length of the name found
+       */
+      _retpure std::pair<std::size_t, std::size_t> findValuePrefix(std::string_view arg) const;
+
+      /**
+       * Returns the record of the option on the given index.
+       *
+       * @param[in] i The index as returned by find
+       * @return The record of the option
+       */
+      _retpure const OptionRecord_& operator[](std::size_t i) const;
+
+      /**
+       * Returns the number of options indexed.
+       */
+      _retpure std::size_t size() const;
+
+      /**
+       * Returns a number changed each time an option is added or bound,
+       * so results parsed with the index can tell if they are stale.
+       */
+      _retpure std::size_t version() const;
+
+      /// Fields
+  private:
+      /// The records of the options in registration order
+      std::vector<OptionRecord_> _records;
+      /// The names paired with the index of their option's record;
+      /// the names are in _arena
+      std::vector<std::pair<std::string_view, std::size_t>> _names;
+      /// The storage of the names, made when the first one is added
+      std::shared_ptr<NameArena_> _arena;
+      /// The names compiled for lookup
+      NameTrie_ _trie;
+      /// Whether the trie is up to date with the names
+      bool _frozen = true;
+      /// Whether the trie is in an image, and the names are not copied
+      bool _attached = false;
+      /// Changed by adding or binding an option
+      std::size_t _version = 0;
+
+      /// Methods
+  private:
+      _retpure bool bound(std::size_t option) const;
+  };
+}
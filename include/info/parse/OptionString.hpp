@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
+#include <string_view>
 
 #include "Lazy.hpp"
 #include "utils.hpp"
+#include "NameArena_.hpp"
 
 //&!off
 #ifdef INFO_USE_BOOST
@@ -64,6 +67,10 @@ namespace info::parse::detail {
    * string from which the OptionString is constructed:
    * `"quiet|silent|q|s"`
    *
+   * The names, and the views of them, are stored in one block,
+   * which copies of the object share: copying it, or looking at its
+   * names, allocates nothing.
+   *
    * @note Empty string such as `"opt||o"` are ignored.
    */
   class OptionString {
@@ -72,10 +79,14 @@ namespace info::parse::detail {
       /**
        * Returns the names stored by this object
        *
-       * @return A std::vector of std::string-s containing
-       *          all names with one prepended dash
+       * @return A view of all names with one prepended dash,
+       *          which iterates them without copying
+       *
+       * @note Up to and including `2.1.x` this returned a
+       *       `const std::vector<std::string>&`; since `3.0.0` the view
+       *       is valid as long as the object or a copy of it is.
        */
-      _retpure const std::vector<std::string>& getNames() const;
+      _retpure const NameView& getNames() const;
       /**
        * Returns all names with both a lazily constructed
        * Knuth-Morris-Pratt and Boyer-Moore searcher objects
@@ -89,6 +100,8 @@ namespace info::parse::detail {
        * @note The searcher objects' initialization takes
        *       the name parameter from the same tuple. Any other
        *       std::string is providable but that defeats the purpose.
+       * @note Copies every name and makes new searchers on each call;
+       *       iterate getNames() where the names are enough.
        *
        * @see Internals::searchableOf<T>
        * @see OptionString::operator*()
@@ -120,6 +133,10 @@ namespace info::parse::detail {
        * @note name is not checked for `nullptr`
        */
       OptionString(const char* name);
+      /**
+       * @copydoc OptionString(const std::string&)
+       */
+      OptionString(std::string_view name);
 
       /// Operators
   public:
@@ -131,8 +148,11 @@ namespace info::parse::detail {
        * @return The i-th name of the string
        *
        * @throws std::out_of_range
+       *
+       * @note Up to and including `2.1.x` this returned a
+       *       `const std::string&`; since `3.0.0` a view.
        */
-      _retpure const std::string& operator[](std::vector<std::string>::size_type i) const;
+      _retpure std::string_view operator[](NameView::size_type i) const;
       /**
        * @copydoc get()
        */
@@ -143,16 +163,10 @@ namespace info::parse::detail {
 
       /// Fields
   private:
-      /// The names stored by the object
-      std::vector<std::string> _names;
-      /// Lazily constructed Knuth-Morris-Pratt search objects for each name
-      std::vector<Lazy<FinderEins<char>, std::string&>> _kmpSearch;
-      /// Lazily constructed Boyer-Moore search objects for each name
-      std::vector<Lazy<FinderZwei<char>, std::string&>> _bmSearch;
-
-      /// Methods
-  private:
-      _pure static std::vector<std::string> prependDashes(std::vector<std::string>&& rawNames);
+      /// The block of the names and the views of them
+      std::shared_ptr<const char[]> _block;
+      /// The names, in the block
+      NameView _names;
   };
 }
 
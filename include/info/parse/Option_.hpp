@@ -8,6 +8,7 @@
 #pragma once
 
 #include <utility>
+#include <functional>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -17,19 +18,10 @@
 
 #include "config.hpp"
 #include "utils.hpp"
+#include "Exporter_.hpp"
 #include "OptionString.hpp"
 
 namespace info::parse::detail {
-  /**
-   * Thrown if supplied function callback
-   *  1) takes too many parameters
-   *  2)
-   */
-  class bad_function_callback : public virtual std::logic_error {
-  public:
-      bad_function_callback(int a);
-  };
-
   /**
    * Stores one parsable option with a SHORT
    * and LONG name.
@@ -78,14 +70,15 @@ namespace info::parse::detail {
        * `F` shall be either 1) `R(P)`; or 2) `R(P, Ps)`.<br />
        * In case of `R(P)`:
        *  - `P` shall be either 1) `void`; or 2) std or c-style string; or
-       *    3) any type for which `can_stream<P>` is `true`.
+       *    3) any type ValueParser<P> can convert to.
        *    -# If `P` is `void`, `f` is called like `(*f)()`.
        *    -# If `P` is a string (std, or c-string) `f` will be called directly
        *       with the parsed value. The empty string is a viable value, for example
        *       in case of parsing `"--option="`.
-       *    -# Otherwise according to the parsing rules used by the declared
-       *       `operator>>(std::istream&, P&)`, let `val` be the value of
-       *       type `P` containing the value extraced from said operator;
+       *    -# Otherwise according to the parsing rules of ValueParser<P>,
+       *       which are the ones of the declared `operator>>(std::istream&, P&)`
+       *       unless specialized, let `val` be the value of
+       *       type `P` containing the value extracted;
        *       then `f` will be called as `(*f)(val)`.
        *  - `R` shall be either 1) a `void` type; or 2) pointer type of `pR*`; or
        *    3) any type which can be cast to `int`; or 4) any type which can be converted
@@ -196,10 +189,8 @@ namespace info::parse::detail {
   private:
       /// Names of the option by which it can be parsed
       OptionString names;
-      /// Exporter of type `T` whereto the parsed value will be spit back
-      T* exporter;
-      /// Optional callback-function
-      std::optional<std::function<R(Args...)>> callback;
+      /// Spits the parsed value back either into a `T*` or through a callback
+      Exporter_<T, R, Args...> exporter;
       /// Typedef of `const_iterator` of `std::string`
       typedef std::string::iterator StrCIter;
 
@@ -226,9 +217,8 @@ namespace info::parse::detail {
 
   template<class T, class R, class... Args>
   inline Option_<T, R, Args...>::Option_(OptionString names, T* exporter)
-          : exporter(exporter),
-            names(std::move(names)),
-            callback(std::nullopt) {}
+          : names(std::move(names)),
+            exporter(exporter) {}
 
   template<class U>
   inline std::ostream& operator<<(std::ostream& os, const Option_<U>& option) {
@@ -287,19 +277,6 @@ namespace info::parse::detail {
       auto lp = std::distance(parsee.begin(), l);
       auto fp = std::distance(parsee.begin(), f);
       int bonus = fp + 2 != lp;
-      auto evalVal = [](const std::string& val) {
-        if (val == "yes" || val == "true") { // true values
-            return true;
-        } else if (val == "no" || val == "false") { // false values
-            return false;
-        } else if (anyOf(val[0], "0123456789")) {
-            //starts with digit means we check numeric truthyness
-            return (bool) std::atoi(val.c_str());
-        } else {
-            //if value is only space it is falsy, otherwise truthy
-            return !std::all_of(val.begin(), val.end(), ::isspace);
-        }
-      };
 
       // before anyone asks why the fuck did I even consider and then implement
       // the ability to supply truthyness evaluation as a value to flags;
@@ -313,8 +290,7 @@ namespace info::parse::detail {
           case '=': {
               // +1 for we need not the =
               auto val = parsee.substr(lp + 1, parsee.find(' ', lp) - (lp + 1));
-              to_lower(val);
-              callCallback(std::to_string((int) evalVal(val)));
+              callCallback(std::to_string((int) isTruthy(val)));
               parsee.erase(fp - bonus, lp - (fp - bonus) + 2 + val.size()); // +2 for '=' & trailing space
               return 1;
           }
@@ -328,8 +304,7 @@ namespace info::parse::detail {
               auto whitespaces = firstNonSpace - (lp + 1);
               auto endOfValue = parsee.find(' ', firstNonSpace);
               auto val = parsee.substr(firstNonSpace, endOfValue - firstNonSpace);
-              to_lower(val);
-              callCallback(std::to_string((int) evalVal(val)));
+              callCallback(std::to_string((int) isTruthy(val)));
               parsee.erase(fp - bonus,
                            lp - (fp - bonus) + whitespaces + 2 + val.size()); // +2 for ':' & trailing space
               return 1;
@@ -438,12 +413,6 @@ namespace info::parse::detail {
   template<class T, class R, class... Args>
   std::string Option_<T, R, Args...>::iterateNamesOnWith(std::string parsee,
                                                          bool flag) const {
-      typedef std::string::size_type strsize_t;
-      auto useBMH = []([[maybe_unused]] strsize_t parsedSize,
-                       [[maybe_unused]] strsize_t parseeSize) {
-        return parsedSize > 10;
-      };
-
       auto getParser = [&](bool flag_) {
         if (flag_) {
             return &Option_::parseFlag;
@@ -452,218 +421,24 @@ namespace info::parse::detail {
         }
       };
 
-      for (auto &&[name, kmp, bmh] : *names) {
-          if (useBMH(name.size(), parsee.size())) {
-              // If relative long jumps are possible use boyer-moore-horspool
-              (this->*getParser(flag))(parsee,
-                                       bmh(name)(parsee.begin(), parsee.end()));
-          } else {
-              // otherwise fall-back on knuth-morris-pratt
-              (this->*getParser(flag))(parsee,
-                                       kmp(name)(parsee.begin(), parsee.end()));
-          }
+      // the names are short, so the naive search beats building
+      // a Knuth-Morris-Pratt or Boyer-Moore searcher each time
+      for (auto&& name : names.getNames()) {
+          (this->*getParser(flag))(parsee,
+                                   std::default_searcher(name.begin(), name.end())(parsee.begin(), parsee.end()));
       }
       return parsee;
   }
 
-  // Do not enter unless certified Template Templar
-  /****************************************************************************/
-  template<class, class...>
-  struct TypeD;
-
-  template<class T1>
-  constexpr std::tuple<TypeD<T1>*, int>
-  mkTypeD(T1* v) {
-      return {new TypeD<T1>(v), 0};
-  };
-
-  template<class T1, class... Args>
-  constexpr std::tuple<TypeD<T1, Args...>*, bool>
-  mkTypeD(T1 (* f)(Args...)) {
-      return {new TypeD<T1, Args...>(f), false};
-  }
-
-  template<class Fst = none, class...>
-  struct fP {
-      using Type = Fst;
-  };
-
-  template<class = none, class Snd = none, class...>
-  struct sP {
-      using Type = Snd;
-  };
-
   template<class T, class R, class... Args>
-  void Option_<T, R, Args...>::callCallback(const std::string& value) const {
-      if constexpr (std::is_same_v<T, none>) {
-          auto checkReturnAndRetryIfNeed = [](const std::function<R(Args...)>& f,
-                                              Args... args) {
-//          if (config::RetryFailedCallback) {
-            if constexpr (std::is_pointer_v<R>) {
-                if (config::DeleteCallbackReturn) {
-                    auto ptr = f(args...);
-                    if (ptr == nullptr) {
-                        ptr = f(args...); // Retry failed func
-                    }
-                    delete ptr;
-                } else {
-                    if (f(args...) == nullptr) {
-                        f(args...); // Retry failed func
-                    }
-                }
-            } else if constexpr (std::is_convertible_v<R, int>) {
-                unless (((int) f(args...)) == 0) {
-                    f(args...); // Retry failed func
-                }
-            } else if constexpr (std::is_convertible_v<R, bool>) {
-                unless ((bool) f(args...)) {
-                    f(args...); // Retry failed func
-                }
-            } else {
-                f(args...);
-            }
-//          } else f();
-          };
-
-          using Arg1 = std::remove_cv_t<std::remove_reference_t<typename fP<Args...>::Type>>;
-          using Arg2 = std::remove_cv_t<std::remove_reference_t<typename sP<Args...>::Type>>;
-
-          auto makeArg = [](const std::string& value) -> Arg1 {
-            if constexpr (std::is_same_v<Arg1, std::string>) {
-                // String is output directly
-                return value;
-            }
-            std::istringstream ss(value);
-            Arg1 arg1;
-            ss >> arg1;
-            return arg1;
-          };
-
-          // Give me switch constexpr pls
-          constexpr std::size_t args = sizeof...(Args);
-          if constexpr (args == 0) {
-              checkReturnAndRetryIfNeed(*callback);
-          } else if constexpr (args == 1) {
-              checkReturnAndRetryIfNeed(*callback, makeArg(value));
-          } else if constexpr (args == 2) {
-              if constexpr (std::is_same_v<Arg2, std::string>) {
-                  // exporter takes 2 values
-                  checkReturnAndRetryIfNeed(*callback, makeArg(value), value);
-              } else if constexpr (std::is_pointer_v<Arg2>) {
-                  // You asked for it
-                  checkReturnAndRetryIfNeed(*callback, makeArg(value), (Arg2) value.c_str());
-              } else // Hope this makes sense
-                  checkReturnAndRetryIfNeed(*callback, makeArg(value), Arg2{});
-          } else if (!config::FailSilently) {
-              throw bad_function_callback(sizeof...(Args));
-          }
-      } else {
-          auto td = mkTypeD(exporter);
-          using TDType = decltype(td);
-          using Typ =
-          typename std::remove_pointer_t<std::tuple_element_t<0, TDType>>;
-          using SecTyp = std::tuple_element_t<1, TDType>;
-
-          if constexpr (std::is_same_v<SecTyp, bool>) {
-              using Re = typename Typ::Ret;
-              using Arg1 = std::remove_cv_t<std::remove_reference_t<typename Typ::Arg0>>;
-              using Arg2 = std::remove_cv_t<std::remove_reference_t<typename Typ::Arg1>>;
-
-              auto callF = [&]() -> Re {
-                auto makeArg = [](const std::string& value) -> Arg1 {
-                  if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Arg1>>,
-                          std::string>) {
-                      // String is output directly
-                      return value;
-                  }
-                  std::istringstream ss(value);
-                  Arg1 arg1;
-                  ss >> arg1;
-                  return arg1;
-                };
-
-                if constexpr (std::is_same_v<Arg1, none>) {
-                    // exporter takes no parameters
-                    return (*exporter)();
-                } else if constexpr (std::is_same_v<Arg2, none>) {
-                    // exporter takes 1 parameter
-                    return (*exporter)(makeArg(value));
-                } else if constexpr (std::is_same_v<std::remove_reference_t<std::remove_cv_t<Arg2>>,
-                        std::string>) {
-                    // exporter takes 2 values
-                    return (*exporter)(makeArg(value), value);
-                } else if constexpr (std::is_pointer_v<Arg2>) {
-                    // You asked for it
-                    return (*exporter)(makeArg(value), (Arg2) value.c_str());
-                } else
-                    // Hope this makes sense
-                    return (*exporter)(makeArg(value), Arg2{});
-              };
-
-              if constexpr (std::is_pointer_v<Re>) {
-                  if (callF() == nullptr) {
-                      callF(); // Retry failed func
-                  }
-              }
-              if constexpr (std::is_convertible_v<Re, int>) {
-                  unless (((int) callF()) == 0) {
-                      callF(); // Retry failed func
-                  }
-              }
-              if constexpr (std::is_convertible_v<Re, bool>) {
-                  unless ((bool) callF()) {
-                      callF(); // Retry failed func
-                  }
-              }
-              // Not checking success
-              callF();
-          } else {
-              if constexpr (std::is_same_v<std::remove_reference_t<std::remove_cv_t<T>>,
-                      std::string>) {
-                  // String is output directly
-                  *exporter = value;
-              } else if (value != "") {
-                  std::istringstream ss(value);
-                  ss >> *exporter;
-              } else {
-                  T val{};
-                  *exporter = val;
-              }
-          }
-
-          delete std::get<0>(td);
-      }
+  inline void Option_<T, R, Args...>::callCallback(const std::string& value) const {
+      exporter(value);
   }
 
-  template<class T1, class... Args>
-  struct TypeD {
-      typedef T1 Ret;
-
-      template<class Fst = none, class...>
-      struct fP {
-          using Type = Fst;
-      };
-
-      template<class = none, class Snd = none, class...>
-      struct sP {
-          using Type = Snd;
-      };
-
-      using Arg0 = typename fP<Args...>::Type;
-      using Arg1 = typename sP<Args...>::Type;
-
-      typedef T1 (* func)(Args...);
-
-      TypeD(func& f) {}
-
-      TypeD(T1*& val) {}
-  };
-
-  /****************************************************************************/
   template<class T, class R, class... Args>
   Option_<T, R, Args...>::Option_(OptionString names, const std::function<R(Args...)>& func)
-          : names(names),
-            exporter(nullptr),
-            callback(func) {}
+          : names(std::move(names)),
+            exporter(func) {}
 }
 
+
@@ -11,17 +11,27 @@
 #pragma once
 
 #include <typeinfo>
-#include <typeindex>
 #include <string>
-#include <map>
 #include <memory>
 #include <iterator>
+#include <algorithm>
 #include <regex>
 
 #include "config.hpp"
 #include "utils.hpp"
+#include "Exporter_.hpp"
 #include "OptionHandler_.hpp"
+#include "OptionIndex_.hpp"
 #include "OptionString.hpp"
+#include "ParseSession_.hpp"
+#include "ParseResult.hpp"
+#include "CompiledParser.hpp"
+#include "EventDispatch_.hpp"
+#include "ArgFrame.hpp"
+#include "CmdlineCorpus.hpp"
+#include "ParseStream.hpp"
+#include "ParseCache_.hpp"
+#include "OptionImage.hpp"
 
 /**
  * Main namespace for the library.
@@ -144,9 +154,9 @@ namespace info::parse {
        *                 which the parsed value will be put
        *
        * @note `nullptr` for exporter is not checked, yet
-       * @note T must support operator>> from istream,
-       *       and operator<< from ostream; this
-       *       is made sure by SFINAE so it will die compile time
+       * @note T must be convertible by ValueParser<T>: either ValueParser
+       *       is specialized for it, or it supports operator>> from istream;
+       *       this is made sure by SFINAE so it will die compile time
        * @note The following is advised, otherwise the library doesn't
        *        define any explicit behaviour
        *        @code
@@ -156,11 +166,11 @@ namespace info::parse {
        *        (ss << inVal) >> outVal;
        *        inVal == outVal;
        *        @endcode
-       * @note Option names are not checked, so one of the options
-       *        will shadow the other, depending their position in the std::map
+       * @note Option names are not checked for clashes; if two options
+       *        share a name, the one added first is matched by it
        */
       template<class T>
-      std::enable_if_t<std::is_function_v<T> || (detail::can_stream_v<T>
+      std::enable_if_t<std::is_function_v<T> || (detail::can_parse_v<T>
                                                  && std::is_default_constructible_v<T>),
               OptionsParser&>
       addOption(detail::OptionString name, T* exporter);
@@ -169,15 +179,52 @@ namespace info::parse {
       OptionsParser& addOption(detail::OptionString name,
                                identity_t<const std::function<R(Args...)>&> f);
 
+      /**
+       * Binds an option of the OptionImage the parser was made from
+       * to a variable of type T, or to a callback; the same as adding
+       * it with its names, without splitting or indexing them.
+       * Binding an option again replaces what it was bound to.
+       *
+       * @tparam T Type for the exported value
+       * @param[in] option The position of the option in the image,
+       *                   as returned by OptionImage::option()
+       * @param[out] exporter A pointer to a memory block of type T, into
+       *                      which the parsed value will be put
+       * @return A reference to this object to allow chain-calling
+       *
+       * @throws std::out_of_range if there is no such option
+       *
+       * @see OptionImage
+       */
+      template<class T>
+      std::enable_if_t<std::is_function_v<T> || (detail::can_parse_v<T>
+                                                 && std::is_default_constructible_v<T>),
+              OptionsParser&>
+      addOption(std::size_t option, T* exporter);
+
+      template<class R, class... Args>
+      OptionsParser& addOption(std::size_t option,
+                               identity_t<const std::function<R(Args...)>&> f);
+
       /**
        * Parses the given arguments using parameters in
        * the style of `int main` parameters.
        *
+       * Each argument is resolved through the names of the options,
+       * instead of concatenating them and having every option search
+       * the resulting string, so the time it takes only depends on the
+       * amount of arguments, not on the amount of options.
+       * The names of options do not shadow each other according to
+       * registration order: the exact name is matched first, and
+       * glued values are taken by the option with the longest name.
+       * Values are handed to the options once all arguments have been
+       * parsed, in the order they were found; see independent().
+       *
        * @param[in] argc The length of argv
        * @param[in] argv An array of char arrays which store the
        *             parameters split up by the local shell
-       * @returns The remnants of the parsed concatenated string,
-       *         matched options removed.
+       * @returns The arguments not belonging to any option, concatenated
+       *         as by makeMonolithArgs
        *
        * @note In the future the return value might change to return
        *       a pair of int and char**
@@ -186,24 +233,276 @@ namespace info::parse {
        */
       std::string parse(int argc, char** argv);
 
+      /**
+       * Parses the given arguments using parameters in
+       * the style of `int main` parameters, without copying them.
+       *
+       * Values handed to callbacks taking `std::string_view` and the
+       * remaining arguments are views into the memory of argv,
+       * no argument is copied or escaped.
+       *
+       * @param[in] argc The length of argv
+       * @param[in] argv An array of char arrays which store the
+       *             parameters split up by the local shell
+       * @param[out] rest The arguments not belonging to any option are
+       *             appended here; reusing the same vector between calls
+       *             avoids allocating
+       *
+       * @note Once warmed up, parsing does not allocate at all: with
+       *       a vector that has room for the rest, and
+       *       variables and callbacks that do not allocate themselves,
+       *       like strings with enough capacity, or `std::string_view`
+       *       callbacks, no heap allocation is made.
+       *
+       * @note argv is not checked for `nullptr`
+       * @note for any i < argc; argv[i] is not checked for `nullptr`
+       */
+      void parse(int argc, const char* const* argv, std::vector<std::string_view>& rest);
+
+      /**
+       * Parses arguments already split, without copying them; the
+       * same as parse(int, const char* const*, std::vector<std::string_view>&),
+       * for arguments that are views, like the records of a CmdlineCorpus.
+       *
+       * @param[in] args The arguments, whose memory has to outlive rest
+       * @param[out] rest The arguments not belonging to any option are
+       *             appended here
+       */
+      void parse(const std::vector<std::string_view>& args, std::vector<std::string_view>& rest);
+
+      /**
+       * Parses the first frame of arguments in the binary argv format,
+       * in place: the arguments are read straight out of the buffer,
+       * without unescaping or splitting anything, the same as if they
+       * were given as argv.
+       *
+       * The whole frame is checked before any argument is parsed, so a
+       * malformed frame changes nothing, neither the options nor rest.
+       *
+       * @param[in] frames The buffer, starting with a frame made by
+       *                   encodeArgs(); it has to outlive rest
+       * @param[out] rest The arguments not belonging to any option are
+       *             appended here, as views into the buffer
+       * @return The size of the frame in bytes, so the buffer can be
+       *         advanced to the next frame
+       * @throws std::invalid_argument if the frame is truncated or malformed
+       *
+       * @see encodeArgs()
+       */
+      std::size_t parseFrame(std::string_view frames, std::vector<std::string_view>& rest);
+
       /**
        * Parses the given string as if it was directly input from
        * the local shell
        *
+       * Whitespace is collapsed and bundles not naming an option
+       * are exploded, then the arguments between the spaces are
+       * parsed one by one like the arguments of argv are. Matched options are not erased
+       * from the string, the arguments surviving are only collected
+       * as views, and joined once at the end.
+       *
        * @param[in] args The string to parse
-       * @return The remnants of the parsed string, matched options removed.
+       * @return The arguments not belonging to any option, concatenated
+       *         as by makeMonolithArgs, so `"prog a b"` is returned
+       *         as `" prog a b "`
        */
       std::string parse(const std::string& args);
 
+      /**
+       * Opens a stream to parse a command line fed one argument at a
+       * time, each value handed over as soon as it is complete.
+       *
+       * @code
+       * auto stream = parser.stream();
+       * stream.feed("--output:");
+       * // later
+       * stream.feed("out.txt"); // output is set here
+       * stream.finish();
+       * @endcode
+       *
+       * @return The stream; this parser has to outlive it
+       *
+       * @see ParseStream
+       */
+      _retval ParseStream stream();
+
+      /**
+       * Parses a batch of strings, each as if it was directly input
+       * from the local shell, on multiple threads.
+       *
+       * Values are not exported, as the threads would race for the
+       * variables of the options, but recorded into one ParseResult
+       * for each string, which can later be applied, or queried.
+       * The lines are split among the threads, which steal lines from
+       * each other once done with their own, so a few long lines
+       * do not leave the other threads idle. All threads resolve names
+       * through the same options, and each reuses its own buffers
+       * for all the lines it parses.
+       *
+       * @code
+       * auto results = parser.parseMany(lines);
+       * for (auto&& result : results) {
+       *     parser.apply(result);
+       *     // use the exported variables
+       * }
+       * @endcode
+       *
+       * @tparam Range A range of anything convertible to std::string_view
+       * @param[in] lines The strings to parse
+       * @param[in] threads The most threads to use, at most one for
+       *             each hardware thread; 0 means one for each.
+       *             The threads are shared by all parsers of the process,
+       *             and kept running between batches
+       * @return The result of each line, in the order of lines
+       *
+       * @note Callbacks are not called
+       * @see apply()
+       * @see compile()
+       */
+      template<class Range>
+      std::vector<ParseResult> parseMany(const Range& lines, std::size_t threads = 0);
+
+      /**
+       * Makes an immutable snapshot of the options, which can be
+       * shared by any amount of threads parsing at the same time,
+       * without locking.
+       *
+       * Options added later are not part of the snapshot.
+       * Values it finds can be exported into the options of this
+       * parser with apply().
+       *
+       * @return The snapshot
+       */
+      _retval CompiledParser compile();
+
+      /**
+       * Exports the values of a result, as if the line it was
+       * parsed from was parsed by this parser.
+       *
+       * @param[in] result A result returned by parseMany() of this parser,
+       *             or by a CompiledParser compiled from it
+       */
+      void apply(const ParseResult& result);
+
+      /**
+       * Marks the option added, or bound, last as independent: its callback
+       * does not depend on, or touch anything touched by, any other
+       * option's callback, so they can run in parallel.
+       *
+       * Found values are handed to the options once all arguments
+       * have been parsed, as one batch in the order they were found.
+       * With an executor set, the callbacks of independent options in
+       * the batch are run on it, in parallel; while the values of other
+       * options are handed over on the parsing thread, after all
+       * independent callbacks before them are done.
+       *
+       * @code
+       * parser.addOption<void, const std::string&>("config|c", loadConfig)
+       *       .independent();
+       * @endcode
+       *
+       * @return A reference to this object to allow chain-calling
+       * @throws std::out_of_range if no option was added yet
+       *
+       * @see setExecutor()
+       */
+      OptionsParser& independent();
+
+      /**
+       * Sets how many times the callback of the option added, or bound, last
+       * is called with each of its values. By default, it is called
+       * exactly once.
+       *
+       * @code
+       * parser.addOption<bool, const std::string&>("connect|c", connect)
+       *       .withPolicy(CallbackPolicy::retry(3, std::chrono::milliseconds(50)));
+       * @endcode
+       *
+       * @param[in] policy The policy to call the callback by
+       * @return A reference to this object to allow chain-calling
+       * @throws std::out_of_range if no option was added yet
+       *
+       * @see CallbackPolicy
+       */
+      OptionsParser& withPolicy(CallbackPolicy policy);
+
+      /**
+       * Sets the executor to run the callbacks of independent
+       * options on. Without one, all values are handed over in order
+       * on the parsing thread.
+       *
+       * @param[in] executor The executor; empty to unset
+       * @return A reference to this object to allow chain-calling
+       *
+       * @see independent()
+       */
+      OptionsParser& setExecutor(Executor executor);
+
+      /**
+       * Keeps the results of parsing the last few distinct argvs, so
+       * parsing the same arguments again only replays what was found.
+       *
+       * Results are looked up by a hash of the arguments, and confirmed
+       * by comparing them, before each parse of argv, or of a vector of
+       * arguments. A hit hands the stored values to the options, and
+       * returns the stored remaining arguments, without parsing; values
+       * and arguments are views into the arguments given, the same as
+       * if they were parsed. Adding an option empties the cache.
+       *
+       * @code
+       * parser.cacheResults(4096);
+       * // ...
+       * auto stats = parser.cacheStats();
+       * @endcode
+       *
+       * @param[in] capacity The most results kept, the least recently used
+       *            ones are dropped over it; 0 disables caching, the default
+       * @return A reference to this object to allow chain-calling
+       *
+       * @see cacheStats()
+       */
+      OptionsParser& cacheResults(std::size_t capacity);
+
+      /**
+       * Returns how many parses were answered by the cache,
+       * and how many had to parse
+       *
+       * @see cacheResults()
+       */
+      _retpure CacheStats cacheStats() const;
+
+      /// Lifecycle
+  public:
+      OptionsParser() = default;
+
+      /**
+       * Constructs a parser of the options of the image, using the
+       * names in it as they are. None of its options are parsed until
+       * bound with addOption(std::size_t, T*); more options can be added
+       * with their names as usual.
+       *
+       * @param[in] image The image, which has to outlive the parser, and
+       *            the CompiledParsers compiled from it
+       */
+      explicit OptionsParser(const OptionImage& image);
+
       /// Fields
   private:
-      std::map<std::type_index, std::pair<void*,
-              std::function<std::string(void*, const std::string&)>>> _optionHandlers;
-
-      /// Methods & stuff
+      /// The names of all options, for resolving arguments to options
+      detail::OptionIndex_ _index;
+      /// The buffers the found values are gathered in before dispatching
+      detail::EventBuffers_ _events;
+      /// The executor for independent options; may be empty
+      Executor _executor;
+      /// The results of recent parses of argv
+      detail::ParseCache_ _cache;
+      /// The option added or bound last
+      std::size_t _last = detail::OptionIndex_::npos;
+
+      /// Methods
   private:
-      _pure std::string explodeBundledFlags(const std::string& args);
-      _pure std::string equalizeWhitespace(const std::string& args);
+      template<class It>
+      void parseArgs(It begin, It end, std::vector<std::string_view>& rest);
   };
 
   template<class T>
@@ -223,17 +522,13 @@ namespace info::parse {
   }
 
   template<class T>
-  inline std::enable_if_t<std::is_function_v<T> || (detail::can_stream_v<T>
+  inline std::enable_if_t<std::is_function_v<T> || (detail::can_parse_v<T>
                                                     && std::is_default_constructible_v<T>),
           OptionsParser&>
   OptionsParser::addOption(detail::OptionString name, T* exporter) {
-      if (_optionHandlers.find(typeid(T)) == _optionHandlers.end()) {
-          _optionHandlers[typeid(T)].first = (void*) new OptionHandler_<T>();
-          _optionHandlers[typeid(T)].second = [](void* optionVoid, const std::string& args) {
-            return ((OptionHandler_<T>*) optionVoid)->handle(args);
-          };
-      }
-      ((OptionHandler_<T>*) _optionHandlers[typeid(T)].first)->addOption(name, exporter);
+      _index.addOption(name, detail::is_flag_v<T>,
+                       detail::Exporter_<T>(exporter));
+      _last = _index.size() - 1;
       return *this;
   }
 
@@ -241,71 +536,146 @@ namespace info::parse {
   inline OptionsParser& OptionsParser::addOption(detail::OptionString name,
                                                  identity_t<const std::function<R(Args...)>&> f) {
       static_assert(sizeof...(Args) <= 2, "Supplied callback function takes too many arguments");
-      using T = R(Args...);
-      if (_optionHandlers.find(typeid(T)) == _optionHandlers.end()) {
-          _optionHandlers[typeid(T)].first = (void*) new OptionHandler_<detail::none, R, Args...>();
-          _optionHandlers[typeid(T)].second = [](void* optionVoid, const std::string& args) {
-            return ((OptionHandler_<detail::none, R, Args...>*) optionVoid)->handle(args);
-          };
-      }
-      ((OptionHandler_<detail::none, R, Args...>*) _optionHandlers[typeid(T)].first)->addOption(name, f);
+      _index.addOption(name, false,
+                       detail::Exporter_<detail::none, R, Args...>(f));
+      _last = _index.size() - 1;
+      return *this;
+  }
+
+  template<class T>
+  inline std::enable_if_t<std::is_function_v<T> || (detail::can_parse_v<T>
+                                                    && std::is_default_constructible_v<T>),
+          OptionsParser&>
+  OptionsParser::addOption(std::size_t option, T* exporter) {
+      _index.bind(option, detail::is_flag_v<T>, detail::Exporter_<T>(exporter));
+      _last = option;
       return *this;
   }
 
+  template<class R, class... Args>
+  inline OptionsParser& OptionsParser::addOption(std::size_t option,
+                                                 identity_t<const std::function<R(Args...)>&> f) {
+      static_assert(sizeof...(Args) <= 2, "Supplied callback function takes too many arguments");
+      _index.bind(option, false, detail::Exporter_<detail::none, R, Args...>(f));
+      _last = option;
+      return *this;
+  }
+
+  inline OptionsParser::OptionsParser(const OptionImage& image)
+          : _index(image._index) {}
+
   inline std::string OptionsParser::parse(const std::string& args) {
-      std::string parsable(equalizeWhitespace(explodeBundledFlags(args)));
-      for (const auto& handler : _optionHandlers) {
-          parsable = handler.second.second(handler.second.first, parsable);
-      }
-      return parsable;
+      _index.freeze();
+      detail::EventBuffers_::Lease lease(_events);
+      std::vector<std::string_view> rest;
+      detail::EventSink_ sink(lease.events(), rest);
+      detail::StringScratch_ scratch;
+      detail::ParseSession_ session(_index, sink, lease.used());
+      detail::feedString(args, scratch, session);
+      session.finish();
+      detail::dispatchEvents(_index, lease.events(), _executor);
+      return info::parse::joinArgs(rest);
   }
 
-  inline std::string OptionsParser::parse(int argc, char** argv) {
-      return parse(info::parse::makeMonolithArgs(argc, argv));
+  inline ParseStream OptionsParser::stream() {
+      _index.freeze();
+      return ParseStream(_index);
   }
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wfor-loop-analysis"
-#pragma ide diagnostic ignored "OCDFAInspection"
-
-  inline std::string OptionsParser::explodeBundledFlags(const std::string& args) {
-      bool _ = true;
-      std::string parsable(args);
-      std::size_t bundleStart = 0;
-      std::string bundleSequence(" -");
-
-      //&!off
-      for (;_;) {
-      //&!on
-          bundleStart = parsable.find(bundleSequence, bundleStart);
-          if (bundleStart == -1) break;
-          if (parsable[bundleStart + 2] == '-' && ++bundleStart) continue;
-
-          std::size_t bundleEnd = parsable.find(' ', bundleStart + 1);
-          std::size_t bundleSize = bundleEnd - bundleStart - 1;
-          if (bundleSize <= 1 && ++bundleStart) continue;
-
-          std::string bundle = parsable.substr(bundleStart, bundleSize + 1);
-          parsable.erase(bundleStart, bundleSize + 1);
-          std::stringstream explodedBundleStream;
-          for (const auto& ch : bundle) {
-              unless (ch == ' ' || ch == '-') {
-                  explodedBundleStream << " -" << ch << ' ';
-              }
-          }
-          std::string explodedBundle = explodedBundleStream.str();
+  template<class Range>
+  inline std::vector<ParseResult> OptionsParser::parseMany(const Range& lines,
+                                                           std::size_t threads) {
+      return compile().parseMany(lines, threads);
+  }
+
+  inline CompiledParser OptionsParser::compile() {
+      _index.freeze();
+      return CompiledParser(_index);
+  }
 
-          parsable.insert(bundleStart, explodedBundle);
-          bundleStart++;
+  inline void OptionsParser::apply(const ParseResult& result) {
+      _index.freeze();
+      detail::EventBuffers_::Lease lease(_events);
+      for (std::size_t i = 0; i < result.size(); ++i) {
+          lease.events().push_back({result.option(i), result.value(i)});
       }
+      detail::dispatchEvents(_index, lease.events(), _executor);
+  }
+
+  inline OptionsParser& OptionsParser::independent() {
+      _index.markIndependent(_last);
+      return *this;
+  }
+
+  inline OptionsParser& OptionsParser::withPolicy(CallbackPolicy policy) {
+      _index.setPolicy(_last, policy);
+      return *this;
+  }
+
+  inline OptionsParser& OptionsParser::setExecutor(Executor executor) {
+      _executor = std::move(executor);
+      return *this;
+  }
+
+  inline OptionsParser& OptionsParser::cacheResults(std::size_t capacity) {
+      _cache.resize(capacity);
+      return *this;
+  }
 
-      return parsable;
+  inline CacheStats OptionsParser::cacheStats() const {
+      return _cache.stats();
   }
 
-#pragma clang diagnostic pop
+  inline std::string OptionsParser::parse(int argc, char** argv) {
+      std::vector<std::string_view> rest;
+      parse(argc, argv, rest);
+      return info::parse::makeMonolithArgs(rest);
+  }
 
-  inline std::string OptionsParser::equalizeWhitespace(const std::string& args) {
-      return std::regex_replace(args, std::regex("\\s+"), " ");
+  inline void OptionsParser::parse(int argc, const char* const* argv,
+                                   std::vector<std::string_view>& rest) {
+      parseArgs(argv, argv + argc, rest);
+  }
+
+  inline void OptionsParser::parse(const std::vector<std::string_view>& args,
+                                   std::vector<std::string_view>& rest) {
+      parseArgs(args.begin(), args.end(), rest);
+  }
+
+  template<class It>
+  inline void OptionsParser::parseArgs(It begin, It end, std::vector<std::string_view>& rest) {
+      _index.freeze();
+      detail::EventBuffers_::Lease lease(_events);
+      if (_cache.enabled()) {
+          unless (_cache.replay(begin, end, _index.version(), lease.events(), rest)) {
+              detail::EventSink_ sink(lease.events(), rest);
+              _cache.parse(_index, sink, lease.used());
+          }
+      } else {
+          detail::EventSink_ sink(lease.events(), rest);
+          detail::ParseSession_ session(_index, sink, lease.used());
+          for (auto it = begin; it != end; ++it) {
+              session.feed(*it);
+          }
+          session.finish();
+      }
+      detail::dispatchEvents(_index, lease.events(), _executor);
+  }
+
+  inline std::size_t OptionsParser::parseFrame(std::string_view frames,
+                                               std::vector<std::string_view>& rest) {
+      _index.freeze();
+      detail::EventBuffers_::Lease lease(_events);
+      detail::EventSink_ sink(lease.events(), rest);
+      detail::ParseSession_ session(_index, sink, lease.used());
+      detail::ArgFrameReader_ reader(frames);
+      std::string_view arg;
+      while (reader.next(arg)) {
+          session.feed(arg);
+      }
+      session.finish();
+      detail::dispatchEvents(_index, lease.events(), _executor);
+      return reader.consumed();
   }
 
   inline OptionAdder OptionsParser::addOptions() {
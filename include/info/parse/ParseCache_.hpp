@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "utils.hpp"
+#include "OptionIndex_.hpp"
+#include "EventDispatch_.hpp"
+
+namespace info::parse {
+  /**
+   * How well the parse cache of an OptionsParser did
+   *
+   * @see OptionsParser::cacheResults()
+   */
+  struct CacheStats {
+      /// The parses answered from the cache
+      std::size_t hits = 0;
+      /// The parses that had to parse the arguments
+      std::size_t misses = 0;
+  };
+
+  namespace detail {
+    /**
+     * A bounded cache of the results of parsing argv, dropping the
+     * least recently used one when full.
+     *
+     * Results are keyed by a hash of the arguments, and confirmed by
+     * comparing the arguments themselves, so a collision is only a miss.
+     * A result is the events found and the arguments left over, stored
+     * by the position of their argument, and where the value is in
+     * it; so replaying a result makes views into the arguments replayed,
+     * exactly like parsing them would, without storing any value.
+     * Values not in any argument, like the ones of flags, are static
+     * strings, and kept as they are.
+     *
+     * Results depend on the options, so the cache is emptied whenever
+     * the version of the index differs from the last parse, which is
+     * when an option was added or bound.
+     */
+    class ParseCache_ {
+        /// Interface
+    public:
+        /**
+         * Returns whether results are cached at all
+         */
+        _retpure bool enabled() const;
+
+        /**
+         * Sets the most results kept, dropping the least recently
+         * used ones over it
+         *
+         * @param[in] capacity The most results; 0 disables the cache
+         */
+        void resize(std::size_t capacity);
+
+        /**
+         * Looks up the result of the arguments, and if found, appends its
+         * events and its remaining arguments, as views into the arguments
+         * given. If not found, the arguments are remembered for parse().
+         *
+         * @param[in] begin The first argument
+         * @param[in] end The end of the arguments
+         * @param[in] version The version of the index
+         * @param[out] events The events to append to
+         * @param[out] rest The remaining arguments to append to
+         * @return Whether the result was cached
+         */
+        template<class It>
+        bool replay(It begin, It end, std::size_t version,
+                    std::vector<ParseEvent_>& events,
+                    std::vector<std::string_view>& rest);
+
+        /**
+         * Parses the arguments replay() did not find, into the sink,
+         * and caches the result.
+         *
+         * @param[in] index The options to parse
+         * @param[in] sink The sink to report to, as a parse would
+         * @param[in,out] used The used options of the session,
+         *                     as ParseSession_ takes them
+         */
+        void parse(const OptionIndex_& index, EventSink_& sink,
+                   std::vector<std::uint64_t>& used);
+
+        /**
+         * Returns the hits and misses so far
+         */
+        _retpure CacheStats stats() const;
+
+        /// Lifecycle
+    public:
+        ParseCache_() = default;
+
+        /// Results are not shared between copies of a parser,
+        /// only the capacity is
+        ParseCache_(const ParseCache_& other);
+        ParseCache_& operator=(const ParseCache_& other);
+
+        /// Fields
+    private:
+        /// An event, stored by the position of its value
+        struct Event {
+            /// The index of the option
+            std::size_t option;
+            /// The argument of the value; npos if it is in none
+            std::size_t arg;
+            /// The value as a range of the argument
+            std::size_t offset, length;
+            /// The value, if it is in no argument
+            std::string_view literal;
+        };
+
+        /// The result of one set of arguments
+        struct Entry {
+            /// The hash of the arguments
+            std::uint64_t hash;
+            /// The arguments, one after the other
+            std::string text;
+            /// The end of each argument in the text
+            std::vector<std::size_t> ends;
+            /// The events found
+            std::vector<Event> events;
+            /// The positions of the arguments left over
+            std::vector<std::size_t> rest;
+        };
+
+        /// The most results kept
+        std::size_t _capacity = 0;
+        /// The version of the index the results were parsed with
+        std::size_t _version = 0;
+        /// The results, the most recently used first
+        std::list<Entry> _entries;
+        /// The results by the hash of their arguments
+        std::unordered_map<std::uint64_t, std::list<Entry>::iterator> _byHash;
+        /// The arguments looked up last, and their hash
+        std::vector<std::string_view> _args;
+        std::uint64_t _hash = 0;
+        /// The hits and misses
+        CacheStats _stats;
+
+        /// Methods
+    private:
+        bool replayArgs(std::size_t version,
+                        std::vector<ParseEvent_>& events,
+                        std::vector<std::string_view>& rest);
+
+        _retval Entry& allocate();
+    };
+
+    template<class It>
+    inline bool ParseCache_::replay(It begin, It end, std::size_t version,
+                                    std::vector<ParseEvent_>& events,
+                                    std::vector<std::string_view>& rest) {
+        _args.assign(begin, end);
+        return replayArgs(version, events, rest);
+    }
+
+    inline bool ParseCache_::enabled() const {
+        return _capacity != 0;
+    }
+
+    inline CacheStats ParseCache_::stats() const {
+        return _stats;
+    }
+
+    inline ParseCache_::ParseCache_(const ParseCache_& other)
+            : _capacity(other._capacity) {}
+
+    inline ParseCache_& ParseCache_::operator=(const ParseCache_& other) {
+        if (this != &other) {
+            resize(0);
+            _capacity = other._capacity;
+            _stats = {};
+        }
+        return *this;
+    }
+  }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+#include "utils.hpp"
+#include "ValueParser.hpp"
+
+namespace info::parse {
+  namespace detail {
+    class RecordingSink_;
+  }
+
+  /**
+   * The outcome of parsing one command line without
+   * exporting anything: the values found for the options,
+   * and what remained.
+   *
+   * Options are identified by their index, which is their
+   * position in registration order, starting from zero.
+   * Values are the raw strings found, `"1"` or `"0"` for
+   * flags, exactly as they would have been handed to the
+   * option's variable or callback.
+   *
+   * All values are stored in one buffer, so a result costs
+   * a few allocations regardless of the amount of options found.
+   *
+   * @see OptionsParser::parseMany()
+   * @see OptionsParser::apply()
+   */
+  class ParseResult {
+      /// Interface
+  public:
+      /**
+       * Returns the amount of options found
+       */
+      _retpure std::size_t size() const;
+
+      /**
+       * Returns the index of the i-th option found, in the order
+       * they were found
+       *
+       * @param[in] i The index of the match; not checked
+       */
+      _retpure std::size_t option(std::size_t i) const;
+
+      /**
+       * Returns the value of the i-th option found
+       *
+       * @param[in] i The index of the match; not checked
+       * @return A view of the value, valid as long as this object
+       *          is not modified or destructed
+       */
+      _retpure std::string_view value(std::size_t i) const;
+
+      /**
+       * Returns the value found for the option
+       *
+       * @param[in] option The index of the option
+       * @return The value if the option was found
+       */
+      _retpure std::optional<std::string_view> find(std::size_t option) const;
+
+      /**
+       * Returns the value found for the option, converted to T
+       * the same way it is when exported into a T variable
+       *
+       * @tparam T The type to convert to
+       * @param[in] option The index of the option
+       * @return The converted value if the option was found, and
+       *         its value was valid for ValueParser<T>
+       */
+      template<class T>
+      _retval std::optional<T> get(std::size_t option) const;
+
+      /**
+       * Returns the arguments that did not belong to any
+       * option, concatenated as by makeMonolithArgs: escaped if
+       * they were given one by one, as they are if they were
+       * parts of a string
+       */
+      _retpure const std::string& rest() const;
+
+      /// Fields
+  private:
+      friend class detail::RecordingSink_;
+
+      struct Match {
+          /// The index of the option
+          std::size_t option;
+          /// The value as a range of _values
+          std::size_t offset, length;
+      };
+
+      /// The options found, in order
+      std::vector<Match> _matches;
+      /// The values one after the other
+      std::string _values;
+      /// The remaining arguments, as joined by joinArgs
+      std::string _rest;
+  };
+
+  template<class T>
+  inline std::optional<T> ParseResult::get(std::size_t option) const {
+      auto found = find(option);
+      unless (found) {
+          return std::nullopt;
+      }
+      T value{};
+      unless (found->empty() || detail::parseValue(*found, value)) {
+          return std::nullopt;
+      }
+      return value;
+  }
+}
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+
+#include "utils.hpp"
+#include "OptionIndex_.hpp"
+#include "ParseResult.hpp"
+
+namespace info::parse::detail {
+  /**
+   * Sink for ParseSession_ that hands each found value
+   * directly to its option and collects the arguments that
+   * did not belong to any option.
+   *
+   * @tparam Index The index the options are stored in
+   */
+  template<class Index = OptionIndex_>
+  class DispatchSink_ {
+      /// Interface
+  public:
+      /**
+       * Hands the value over to the option
+       *
+       * @param[in] option The index of the option in the Index
+       * @param[in] value The value found for the option
+       */
+      void match(std::size_t option, std::string_view value);
+
+      /**
+       * Stores an argument that is not an option, or one that
+       * is, but which has already been parsed
+       *
+       * @param[in] arg The argument
+       */
+      void rest(std::string_view arg);
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the sink
+       *
+       * @param[in] index The index whose options are to be dispatched to
+       * @param[out] rest The collection to store the remaining arguments in
+       */
+      DispatchSink_(const Index& index, std::vector<std::string_view>& rest);
+
+      /// Fields
+  private:
+      /// The index whose records are to be called
+      const Index& _index;
+      /// The remaining arguments
+      std::vector<std::string_view>& _rest;
+  };
+
+  /**
+   * Sink for ParseSession_ that does not touch the options,
+   * but records the found values and the remaining arguments
+   * into a ParseResult, so the values can be exported later,
+   * possibly by another thread.
+   *
+   * The result recorded into can be changed between sessions,
+   * so one sink can be used for many command lines.
+   *
+   * The remaining arguments are joined as by makeMonolithArgs, so
+   * arguments given one by one are escaped, the same as the rest
+   * OptionsParser::parse(int, char**) returns; arguments of a string
+   * are escaped already, and are joined as they are.
+   */
+  class RecordingSink_ {
+      /// Interface
+  public:
+      /**
+       * Records the value for the option
+       *
+       * @param[in] option The index of the option
+       * @param[in] value The value found for the option
+       */
+      void match(std::size_t option, std::string_view value);
+
+      /**
+       * Records an argument that did not belong to any option
+       *
+       * @param[in] arg The argument
+       */
+      void rest(std::string_view arg);
+
+      /**
+       * Clears the result and records into it from now on
+       *
+       * @param[out] result The result to record into
+       */
+      void retarget(ParseResult& result);
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the sink
+       *
+       * @param[out] result The result to record into; cleared
+       * @param[in] escape Whether the remaining arguments are to be
+       *            escaped, as they are not parts of a string
+       */
+      RecordingSink_(ParseResult& result, bool escape);
+
+      /// Fields
+  private:
+      /// The result being recorded
+      ParseResult* _result;
+      /// Whether the remaining arguments are escaped
+      bool _escape;
+  };
+
+  /**
+   * Buffers for parsing a string of arguments: the ones turning it
+   * into arguments, and the used options of the session fed;
+   * kept between parses so their memory is reused.
+   */
+  struct StringScratch_ {
+      /// The string with whitespace collapsed
+      std::string collapsed;
+      /// The collapsed string with its bundles exploded
+      std::string exploded;
+      /// The options used by the session fed
+      std::vector<std::uint64_t> used;
+  };
+
+  /**
+   * Parses arguments one after the other, resolving
+   * each through an index of names, either an OptionIndex_ or
+   * a StaticOptionIndex_.
+   *
+   * Each argument is looked at once, and the option it names is
+   * found by its name instead of trying all options, so parsing
+   * is linear in the amount of arguments, and does not depend on
+   * the amount of options registered.
+   * The parsing rules are the same as the ones for the string
+   * based parser, with each argument being the unit:
+   *  - `--name` and `-n` set flags, or take the next argument as value
+   *  - `--no-name` clears a flag
+   *  - `--name=val` and `--name:val` take the value after the sign;
+   *    `--name:` takes the next argument as its value
+   *  - `--nameval` takes the value glued to the name of a value option
+   *  - `-abc` is a bundle of short options; if one of them takes a value
+   *    it takes the rest of the bundle, or the next argument
+   * Each option is only matched once, later occurrences are left alone.
+   *
+   * Found values and the remaining arguments are reported to
+   * the Sink, which shall provide:
+   *  - `void match(std::size_t option, std::string_view value)`
+   *  - `void rest(std::string_view arg)`
+   *
+   * Names are resolved through the Index, which shall provide
+   * `npos`, `find(name)`, `findValuePrefix(arg)`, `size()`, and
+   * `operator[]` returning an OptionRecord_, as OptionIndex_ does.
+   *
+   * Values are views into the fed arguments, or static strings
+   * for flags; they are only valid as long as the arguments are.
+   *
+   * @tparam Sink The type to report the results to
+   * @tparam Index The type of the index to resolve names with
+   */
+  template<class Sink, class Index = OptionIndex_>
+  class ParseSession_ {
+      /// Interface
+  public:
+      /**
+       * Parses the next argument
+       *
+       * @param[in] arg The argument as split up by the shell
+       */
+      void feed(std::string_view arg);
+
+      /**
+       * Finishes parsing. If an option is still waiting for its
+       * value, it gets the empty string, or false if a flag.
+       */
+      void finish();
+
+      /**
+       * Forgets everything about the arguments fed so far, so the
+       * session can parse another set of arguments with the same
+       * sink, without reallocating.
+       */
+      void reset();
+
+      /**
+       * Returns whether an option is waiting for the next argument
+       * as its value
+       */
+      _retpure bool pending() const;
+
+      /**
+       * Returns whether the argument is the name of an option, alone
+       * or followed by its value after `=` or `:`; such an argument,
+       * like `-quiet`, is resolved by its name before it is taken
+       * as a bundle of short options
+       *
+       * @param[in] arg The argument, with its dashes
+       */
+      _retpure bool names(std::string_view arg) const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs a session to parse one set of arguments with.
+       *
+       * The bitset of used options is kept by the caller, so a parser
+       * reusing it between parses does not allocate it again,
+       * whatever the amount of options.
+       *
+       * @param[in] index The options to parse
+       * @param[in] sink The object to report the results to
+       * @param[in,out] used The storage of the used options;
+       *                     cleared and sized to the index
+       */
+      ParseSession_(const Index& index, Sink& sink, std::vector<std::uint64_t>& used);
+
+      /// Fields
+  private:
+      /// The options
+      const Index& _index;
+      /// The receiver of results
+      Sink& _sink;
+      /// Whether an option has been matched already, one bit each
+      std::vector<std::uint64_t>& _used;
+      /// The option waiting for the next argument as its value
+      std::size_t _pending = Index::npos;
+
+      /// Methods
+  private:
+      _retval bool resolve(std::string_view arg);
+
+      _retval bool resolveBundle(std::string_view arg);
+
+      _retpure bool available(std::size_t option) const;
+
+      void markUsed(std::size_t option);
+
+      void emit(std::size_t option, std::string_view value);
+
+      void take(std::size_t option, std::string_view value);
+
+      void pend(std::size_t option);
+  };
+
+  /**
+   * Feeds a string of arguments, as if input directly from the
+   * local shell, to a session: whitespace is collapsed and bundles
+   * are exploded, then the arguments between the spaces are fed
+   * one by one. The session is not finished.
+   *
+   * Bundles naming an option, like `-quiet`, are not exploded, so they
+   * are resolved the same as when fed one by one, from argv.
+   *
+   * The arguments fed are views into the scratch buffers, so they
+   * are only valid until the scratch is used again.
+   *
+   * @param[in] args The string to parse
+   * @param[in,out] scratch The buffers to use
+   * @param[in,out] session The session to feed
+   */
+  template<class Session>
+  void feedString(std::string_view args, StringScratch_& scratch, Session& session);
+
+  inline RecordingSink_::RecordingSink_(ParseResult& result, bool escape)
+          : _result(nullptr),
+            _escape(escape) {
+      retarget(result);
+  }
+
+  inline void RecordingSink_::retarget(ParseResult& result) {
+      _result = &result;
+      _result->_matches.clear();
+      _result->_values.clear();
+      _result->_rest.assign(1, ' ');
+  }
+
+  inline void RecordingSink_::match(std::size_t option, std::string_view value) {
+      _result->_matches.push_back({option, _result->_values.size(), value.size()});
+      _result->_values += value;
+  }
+
+  inline void RecordingSink_::rest(std::string_view arg) {
+      if (_escape) {
+          appendMonolithArg(arg, _result->_rest);
+          return;
+      }
+      _result->_rest += arg;
+      _result->_rest += ' ';
+  }
+
+  template<class Index>
+  inline DispatchSink_<Index>::DispatchSink_(const Index& index,
+                                             std::vector<std::string_view>& rest)
+          : _index(index),
+            _rest(rest) {}
+
+  template<class Index>
+  inline void DispatchSink_<Index>::match(std::size_t option, std::string_view value) {
+      _index[option].accept(value);
+  }
+
+  template<class Index>
+  inline void DispatchSink_<Index>::rest(std::string_view arg) {
+      _rest.push_back(arg);
+  }
+
+  template<class Sink, class Index>
+  inline ParseSession_<Sink, Index>::ParseSession_(const Index& index, Sink& sink,
+                                                   std::vector<std::uint64_t>& used)
+          : _index(index),
+            _sink(sink),
+            _used(used) {
+      // keeps the capacity of the last parse
+      _used.assign((index.size() + 63) / 64, 0);
+  }
+
+  template<class Sink, class Index>
+  void ParseSession_<Sink, Index>::feed(std::string_view arg) {
+      if (_pending != Index::npos) {
+          take(std::exchange(_pending, Index::npos), arg);
+          return;
+      }
+      unless (resolve(arg)) {
+          _sink.rest(arg);
+      }
+  }
+
+  template<class Sink, class Index>
+  void ParseSession_<Sink, Index>::finish() {
+      if (_pending != Index::npos) {
+          take(std::exchange(_pending, Index::npos), "");
+      }
+  }
+
+  template<class Sink, class Index>
+  inline void ParseSession_<Sink, Index>::reset() {
+      std::fill(_used.begin(), _used.end(), 0);
+      _pending = Index::npos;
+  }
+
+  template<class Sink, class Index>
+  inline bool ParseSession_<Sink, Index>::pending() const {
+      return _pending != Index::npos;
+  }
+
+  template<class Sink, class Index>
+  inline bool ParseSession_<Sink, Index>::names(std::string_view arg) const {
+      if (_index.find(arg) != Index::npos)
+          return true;
+      auto sep = arg.find_first_of("=:");
+      return sep != std::string_view::npos && _index.find(arg.substr(0, sep)) != Index::npos;
+  }
+
+  template<class Sink, class Index>
+  bool ParseSession_<Sink, Index>::resolve(std::string_view arg) {
+      bool isLong = arg.size() > 2 && arg[0] == '-' && arg[1] == '-';
+      bool isShort = !isLong && arg.size() > 1 && arg[0] == '-' && arg[1] != '-';
+      // names are stored with one dash
+      auto key = isLong ? arg.substr(1) : arg;
+
+      auto option = _index.find(key);
+      if (available(option)) {
+          if (_index[option].flag) {
+              emit(option, "1");
+          } else {
+              pend(option);
+          }
+          return true;
+      }
+      unless (isLong || isShort) {
+          return false;
+      }
+
+      // --no-<flag>; short flags are not negatable
+      if (isLong && key.compare(0, 4, "-no-") == 0) {
+          option = _index.find(key.substr(3));
+          if (available(option) && _index[option].flag) {
+              emit(option, "0");
+              return true;
+          }
+      }
+
+      // --name=val, --name:val and --name:
+      auto sep = key.find_first_of("=:");
+      if (sep != std::string_view::npos) {
+          option = _index.find(key.substr(0, sep));
+          if (available(option)) {
+              auto value = key.substr(sep + 1);
+              if (key[sep] == ':' && value.empty()) {
+                  pend(option);
+              } else {
+                  take(option, value);
+              }
+              return true;
+          }
+      }
+
+      if (isShort && key.size() > 2 && resolveBundle(key)) {
+          return true;
+      }
+
+      // --nameval; flags do not take glued values
+      auto[prefixed, length] = _index.findValuePrefix(key);
+      if (available(prefixed)) {
+          take(prefixed, key.substr(length));
+          return true;
+      }
+      return false;
+  }
+
+  template<class Sink, class Index>
+  bool ParseSession_<Sink, Index>::resolveBundle(std::string_view arg) {
+      auto shortOption = [&](std::size_t i) {
+        char name[] = {'-', arg[i]};
+        return _index.find(std::string_view(name, 2));
+      };
+
+      // A bundle is either taken as a whole or left alone
+      for (std::size_t i = 1; i < arg.size(); ++i) {
+          auto option = shortOption(i);
+          unless (available(option)) {
+              return false;
+          }
+          unless (_index[option].flag) {
+              break;
+          }
+      }
+
+      for (std::size_t i = 1; i < arg.size(); ++i) {
+          auto option = shortOption(i);
+          if (_index[option].flag) {
+              // a flag repeated in the bundle, as in -vv, is set once
+              if (arg.find(arg[i], 1) == i) {
+                  emit(option, "1");
+              }
+              continue;
+          }
+          if (i + 1 == arg.size()) {
+              pend(option);
+          } else {
+              take(option, arg.substr(i + 1));
+          }
+          break;
+      }
+      return true;
+  }
+
+  template<class Sink, class Index>
+  inline bool ParseSession_<Sink, Index>::available(std::size_t option) const {
+      return option != Index::npos && !(_used[option / 64] >> (option % 64) & 1u);
+  }
+
+  template<class Sink, class Index>
+  inline void ParseSession_<Sink, Index>::markUsed(std::size_t option) {
+      _used[option / 64] |= std::uint64_t(1) << (option % 64);
+  }
+
+  template<class Sink, class Index>
+  inline void ParseSession_<Sink, Index>::emit(std::size_t option, std::string_view value) {
+      markUsed(option);
+      _sink.match(option, value);
+  }
+
+  template<class Sink, class Index>
+  inline void ParseSession_<Sink, Index>::take(std::size_t option, std::string_view value) {
+      if (_index[option].flag) {
+          emit(option, isTruthy(value) ? "1" : "0");
+      } else {
+          emit(option, value);
+      }
+  }
+
+  template<class Sink, class Index>
+  inline void ParseSession_<Sink, Index>::pend(std::size_t option) {
+      markUsed(option);
+      _pending = option;
+  }
+
+  template<class Session>
+  void feedString(std::string_view args, StringScratch_& scratch, Session& session) {
+      collapseWhitespace(args, scratch.collapsed);
+      explodeBundles(scratch.collapsed, scratch.exploded, [&session](std::string_view bundle) {
+        return session.names(bundle);
+      });
+      std::string_view view(scratch.exploded);
+      for (std::size_t pos = 0; pos < view.size();) {
+          auto end = std::min(view.find(' ', pos), view.size());
+          if (end != pos) {
+              session.feed(view.substr(pos, end - pos));
+          }
+          pos = end + 1;
+      }
+  }
+}
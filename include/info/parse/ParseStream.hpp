@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "utils.hpp"
+#include "OptionIndex_.hpp"
+
+namespace info::parse {
+  class OptionsParser;
+
+  /**
+   * Parses a command line fed one argument at a time, for arguments
+   * that trickle in, like the ones read from a pipe.
+   *
+   * Everything parsing needs is kept between calls: the options
+   * matched so far, and an option still waiting for its value, as after
+   * `--name:`, or after `--name` if it takes a value. So each argument
+   * costs the same however many came before it, and nothing fed is
+   * parsed twice. The rules are the ones parsing argv follows.
+   *
+   * Each value is handed to its option as soon as it is complete, on the
+   * feeding thread, so the fed arguments need not outlive the call; the
+   * executor is not used, even for independent options. Arguments not
+   * belonging to any option are copied into rest().
+   *
+   * @code
+   * auto stream = parser.stream();
+   * std::string arg;
+   * while (std::getline(pipe, arg, '\0')) {
+   *     stream.feed(arg);
+   * }
+   * stream.finish();
+   * @endcode
+   *
+   * @note The parser it was opened from has to outlive the stream, and
+   *       must not get options added while the stream is in use.
+   *
+   * @see OptionsParser::stream()
+   */
+  class ParseStream {
+      /// Interface
+  public:
+      /**
+       * Parses the next argument
+       *
+       * @param[in] arg The argument as split up by the shell
+       * @return A reference to this object to allow chain-calling
+       */
+      ParseStream& feed(std::string_view arg);
+
+      /**
+       * Ends the command line. If an option is still waiting for its
+       * value, it gets the empty string, or false if a flag.
+       */
+      void finish();
+
+      /**
+       * Forgets the arguments fed so far, without finishing them, so
+       * the options can be matched again by another command line.
+       */
+      void reset();
+
+      /**
+       * Returns whether an option is waiting for the next argument
+       * as its value
+       */
+      _retpure bool pending() const;
+
+      /**
+       * Returns the arguments fed that did not belong to any option
+       */
+      _retpure const std::vector<std::string>& rest() const;
+
+      /// Lifecycle
+  public:
+      ParseStream(ParseStream&& other) noexcept;
+      ParseStream& operator=(ParseStream&& other) noexcept;
+
+      ~ParseStream();
+
+      /// Fields
+  private:
+      friend class OptionsParser;
+
+      /// The session and what it reports to, kept in one place so the
+      /// stream can be moved while the session refers to them
+      struct State;
+      std::unique_ptr<State> _state;
+
+      /// Methods
+  private:
+      /**
+       * Opens a stream parsing the given options
+       *
+       * @param[in] index The options; frozen, and outliving the stream
+       */
+      explicit ParseStream(const detail::OptionIndex_& index);
+  };
+}
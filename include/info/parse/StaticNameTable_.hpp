@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <string_view>
+
+#include "utils.hpp"
+#include "StaticOptionString.hpp"
+
+namespace info::parse::detail {
+  /**
+   * The hash used by StaticNameTable_.
+   *
+   * FNV-1a over the characters, finished by a mixing step so
+   * that both halves of the result are usable. As FNV-1a is
+   * computed left to right, the hashes of all prefixes of a
+   * string are got by finishing the running state after
+   * each character.
+   */
+  struct NameHash_ {
+      /// The state before any character is read
+      static constexpr std::uint64_t basis = 14695981039346656037ull;
+
+      /// Reads one more character into the state
+      _pure static constexpr std::uint64_t step(std::uint64_t state, char c) {
+          return (state ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+      }
+
+      /// Finishes the state into the hash
+      _pure static constexpr std::uint64_t finish(std::uint64_t state) {
+          state ^= state >> 33;
+          state *= 0xff51afd7ed558ccdull;
+          state ^= state >> 33;
+          state *= 0xc4ceb9fe1a85ec53ull;
+          return state ^ (state >> 33);
+      }
+
+      /// Hashes the whole string
+      _retpure static constexpr std::uint64_t hash(std::string_view str) {
+          auto state = basis;
+          for (char c : str) {
+              state = step(state, c);
+          }
+          return finish(state);
+      }
+  };
+
+  /**
+   * A perfect hash table of all names of a fixed set
+   * of options, built during constant evaluation.
+   *
+   * The table is built with hash and displace: names are
+   * distributed into buckets by the upper half of their hash,
+   * then, largest bucket first, each bucket is given the smallest
+   * displacement which moves all its names into free slots.
+   * Looking up a name is therefore one hash, one read of the
+   * displacement, and one compare against the only name that
+   * can be in the slot.
+   *
+   * Tables are not meant to be spelled out; they are returned
+   * by makeOptionTable(), and their size parameters are upper bounds
+   * calculated from the length of the literals.
+   *
+   * @tparam Options The amount of options
+   * @tparam Names The most names the options can have
+   * @tparam Chars The most characters all names can take
+   *
+   * @see makeOptionTable()
+   * @see StaticOptionsParser
+   */
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  class StaticNameTable_ {
+      /// Interface
+  public:
+      /// The value returned by find if nothing is found
+      static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+      /// The amount of options in the table
+      static constexpr std::size_t options = Options;
+
+      /**
+       * Returns the option the name belongs to.
+       *
+       * @param[in] name The name with its prepended dash, like `-alpha`
+       * @return The index of the option, or npos
+       */
+      _retpure constexpr std::size_t find(std::string_view name) const;
+
+      /**
+       * Returns the option one of whose names is the name
+       * given as in an OptionString literal, that is without the dash.
+       *
+       * @param[in] name The name without its dash, like `alpha`
+       * @return The index of the option, or npos
+       */
+      _retpure constexpr std::size_t option(std::string_view name) const;
+
+      /**
+       * Calls the function with each name that is a proper prefix
+       * of the argument, shortest first, as `f(option, length)`.
+       * The hashes of the prefixes are computed in one pass.
+       *
+       * @param[in] arg The argument with one dash, like `-alphaval`
+       * @param[in] f The function to call with the found options
+       */
+      template<class F>
+      constexpr void prefixes(std::string_view arg, F&& f) const;
+
+      /**
+       * Returns the amount of distinct names stored
+       */
+      _retpure constexpr std::size_t size() const;
+
+      /// Lifecycle
+  public:
+      constexpr StaticNameTable_() = default;
+
+      /**
+       * Adds the names of the option to the table. If a name is
+       * already taken by an earlier option, the earlier one keeps it.
+       * Names are only found after build() is called.
+       *
+       * @param[in] names The names of the option
+       * @param[in] option The index of the option
+       */
+      template<std::size_t N>
+      constexpr void add(const StaticOptionString<N>& names, std::size_t option);
+
+      /**
+       * Places all names into their slots.
+       *
+       * @throws std::logic_error if the names cannot be placed, which
+       *                          during constant evaluation fails compilation
+       */
+      constexpr void build();
+
+      /// Fields
+  private:
+      struct Entry {
+          /// The name as a range of _chars
+          std::size_t offset, length;
+          /// The option the name belongs to
+          std::size_t option;
+          /// The hash of the name
+          std::uint64_t hash;
+      };
+
+      static constexpr std::size_t slotCount() {
+          std::size_t slots = 1;
+          while (slots < 2 * Names) {
+              slots *= 2;
+          }
+          return slots;
+      }
+
+      /// The amount of slots, a power of two at least twice the names
+      static constexpr std::size_t Slots = slotCount();
+      /// The amount of buckets, a power of two
+      static constexpr std::size_t Buckets = Slots / 4 == 0 ? 1 : Slots / 4;
+
+      /// The names one after the other
+      std::array<char, Chars == 0 ? 1 : Chars> _chars{};
+      std::size_t _charCount = 0;
+      /// The names stored
+      std::array<Entry, Names == 0 ? 1 : Names> _names{};
+      std::size_t _nameCount = 0;
+      /// The length of the longest name
+      std::size_t _longest = 0;
+      /// The displacement of each bucket
+      std::array<std::uint32_t, Buckets> _displacements{};
+      /// One plus the index of the name in each slot, or zero if empty
+      std::array<std::uint32_t, Slots> _slots{};
+
+      /// Methods
+  private:
+      _pure static constexpr std::size_t bucket(std::uint64_t hash);
+
+      _pure static constexpr std::size_t slot(std::uint64_t hash, std::uint32_t displacement);
+
+      _retpure constexpr std::string_view name(const Entry& entry) const;
+
+      _retpure constexpr std::size_t at(std::uint64_t hash, std::string_view name) const;
+
+      _retpure constexpr const Entry* slotted(std::uint64_t hash) const;
+  };
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  template<std::size_t N>
+  constexpr void StaticNameTable_<Options, Names, Chars>::add(const StaticOptionString<N>& names,
+                                                             std::size_t option) {
+      for (std::size_t i = 0; i < names.size(); ++i) {
+          auto str = names[i];
+          bool taken = false;
+          for (std::size_t j = 0; j < _nameCount; ++j) {
+              taken = taken || name(_names[j]) == str;
+          }
+          if (taken)
+              continue;
+
+          _names[_nameCount++] = Entry{_charCount, str.size(), option, NameHash_::hash(str)};
+          for (char c : str) {
+              _chars[_charCount++] = c;
+          }
+          if (str.size() > _longest)
+              _longest = str.size();
+      }
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr void StaticNameTable_<Options, Names, Chars>::build() {
+      // Counting sort the names by bucket, so each bucket is a range
+      std::array<std::size_t, Buckets + 1> begins{};
+      for (std::size_t i = 0; i < _nameCount; ++i) {
+          ++begins[bucket(_names[i].hash) + 1];
+      }
+      std::size_t largest = 0;
+      for (std::size_t b = 0; b < Buckets; ++b) {
+          if (begins[b + 1] > largest)
+              largest = begins[b + 1];
+          begins[b + 1] += begins[b];
+      }
+      std::array<std::size_t, Names == 0 ? 1 : Names> sorted{};
+      std::array<std::size_t, Buckets + 1> filled = begins;
+      for (std::size_t i = 0; i < _nameCount; ++i) {
+          sorted[filled[bucket(_names[i].hash)]++] = i;
+      }
+
+      for (std::size_t size = largest; size > 0; --size) {
+          for (std::size_t b = 0; b < Buckets; ++b) {
+              if (begins[b + 1] - begins[b] != size)
+                  continue;
+
+              bool placed = false;
+              for (std::uint32_t d = 0; d < Slots && !placed; ++d) {
+                  std::size_t i = begins[b];
+                  for (; i < begins[b + 1]; ++i) {
+                      auto& s = _slots[slot(_names[sorted[i]].hash, d)];
+                      if (s != 0)
+                          break;
+                      s = static_cast<std::uint32_t>(sorted[i] + 1);
+                  }
+                  placed = i == begins[b + 1];
+                  if (placed) {
+                      _displacements[b] = d;
+                      break;
+                  }
+                  // Clash; take back what was placed with this displacement
+                  for (std::size_t j = begins[b]; j < i; ++j) {
+                      _slots[slot(_names[sorted[j]].hash, d)] = 0;
+                  }
+              }
+              unless (placed) {
+                  throw std::logic_error("option names cannot be placed into a perfect hash table");
+              }
+          }
+      }
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::size_t StaticNameTable_<Options, Names, Chars>::find(std::string_view name) const {
+      return at(NameHash_::hash(name), name);
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::size_t StaticNameTable_<Options, Names, Chars>::option(std::string_view name) const {
+      if (name == "<>")
+          return find(name);
+      auto state = NameHash_::step(NameHash_::basis, '-');
+      for (char c : name) {
+          state = NameHash_::step(state, c);
+      }
+      auto entry = slotted(NameHash_::finish(state));
+      if (entry == nullptr)
+          return npos;
+      auto stored = this->name(*entry);
+      if (stored.size() != name.size() + 1 || stored.substr(1) != name)
+          return npos;
+      return entry->option;
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  template<class F>
+  constexpr void StaticNameTable_<Options, Names, Chars>::prefixes(std::string_view arg, F&& f) const {
+      auto state = NameHash_::basis;
+      for (std::size_t len = 0; len + 1 < arg.size() && len < _longest; ++len) {
+          state = NameHash_::step(state, arg[len]);
+          auto option = at(NameHash_::finish(state), arg.substr(0, len + 1));
+          if (option != npos) {
+              f(option, len + 1);
+          }
+      }
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::size_t StaticNameTable_<Options, Names, Chars>::size() const {
+      return _nameCount;
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::size_t StaticNameTable_<Options, Names, Chars>::bucket(std::uint64_t hash) {
+      return static_cast<std::size_t>(hash >> 32) & (Buckets - 1);
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::size_t StaticNameTable_<Options, Names, Chars>::slot(std::uint64_t hash,
+                                                                      std::uint32_t displacement) {
+      // The step is odd, so the displacements reach every slot
+      auto step = static_cast<std::uint32_t>(hash >> 40) | 1u;
+      return (static_cast<std::uint32_t>(hash) + displacement * step) & (Slots - 1);
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::string_view StaticNameTable_<Options, Names, Chars>::name(const Entry& entry) const {
+      return std::string_view(_chars.data() + entry.offset, entry.length);
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr std::size_t StaticNameTable_<Options, Names, Chars>::at(std::uint64_t hash,
+                                                                    std::string_view name) const {
+      auto entry = slotted(hash);
+      if (entry == nullptr || this->name(*entry) != name)
+          return npos;
+      return entry->option;
+  }
+
+  template<std::size_t Options, std::size_t Names, std::size_t Chars>
+  constexpr auto StaticNameTable_<Options, Names, Chars>::slotted(std::uint64_t hash) const -> const Entry* {
+      auto index = _slots[slot(hash, _displacements[bucket(hash)])];
+      if (index == 0)
+          return nullptr;
+      return &_names[index - 1];
+  }
+}
+namespace info::parse {
+  /**
+   * Builds the perfect hash table of the names of the options
+   * given as StaticOptionString-s. The i-th option of the table
+   * is the i-th argument.
+   *
+   * Meant to be called as the initializer of a `constexpr` variable,
+   * so all the work is done by the compiler:
+   * @code
+   * constexpr auto table = info::parse::makeOptionTable("quiet|q", "output|o");
+   * static_assert(table.option("q") == 0);
+   * @endcode
+   *
+   * @param[in] names The names of each option
+   * @return The table of the names
+   *
+   * @see StaticOptionsParser
+   */
+  template<std::size_t... N>
+  constexpr auto makeOptionTable(const detail::StaticOptionString<N>& ... names) {
+      detail::StaticNameTable_<sizeof...(N),
+                               (detail::StaticOptionString<N>::capacity + ... + 0),
+                               (detail::StaticOptionString<N>::chars + ... + 0)> table;
+      std::size_t option = 0;
+      (table.add(names, option++), ...);
+      table.build();
+      return table;
+  }
+
+  /**
+   * @copydoc makeOptionTable(const detail::StaticOptionString<N>&...)
+   */
+  template<std::size_t... N>
+  constexpr auto makeOptionTable(const char (& ... names)[N]) {
+      return makeOptionTable(detail::StaticOptionString<N>(names)...);
+  }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+#include <string_view>
+
+#include "utils.hpp"
+#include "OptionIndex_.hpp"
+#include "StaticNameTable_.hpp"
+
+namespace info::parse::detail {
+  /**
+   * The index of a StaticOptionsParser.
+   *
+   * Resolves names through a StaticNameTable_ built at compile
+   * time, and stores the OptionRecord_ bound to each option of
+   * the table. Options which are not bound are not found, so
+   * their names are left alone while parsing.
+   *
+   * Provides the same lookups as OptionIndex_, so ParseSession_
+   * can be used with either.
+   *
+   * @tparam Table The type of the StaticNameTable_
+   */
+  template<class Table>
+  class StaticOptionIndex_ {
+      /// Interface
+  public:
+      /// The value returned by find if nothing is found
+      static constexpr std::size_t npos = Table::npos;
+
+      /**
+       * Binds the record to the option of the table.
+       * Binding an option again replaces its record.
+       *
+       * @param[in] option The index of the option in the table
+       * @param[in] record What to do with the option's values
+       *
+       * @throws std::out_of_range if the table has no such option
+       */
+      void bind(std::size_t option, OptionRecord_ record);
+
+      /**
+       * Sets how many times the callback bound to the option is called
+       *
+       * @param[in] option The index of the option in the table
+       * @param[in] policy The policy to call the callback by
+       *
+       * @throws std::out_of_range if the table has no such option
+       */
+      void setPolicy(std::size_t option, CallbackPolicy policy);
+
+      /**
+       * Looks up the option the name belongs to
+       *
+       * @param[in] name The name with its prepended dash, like `-alpha`
+       * @return The index of the option's record, or npos
+       */
+      _retpure std::size_t find(std::string_view name) const;
+
+      /**
+       * Looks up the value option with the longest name which
+       * is a proper prefix of the argument
+       *
+       * @param[in] arg The argument with one dash, like `-alphaval`
+       * @return The index of the option's record, or npos; and the
+       *          length of its name
+       */
+      _retpure std::pair<std::size_t, std::size_t> findValuePrefix(std::string_view arg) const;
+
+      /**
+       * Returns the record bound to the option
+       */
+      _retpure const OptionRecord_& operator[](std::size_t i) const;
+
+      /**
+       * Returns the amount of options in the table
+       */
+      _retpure std::size_t size() const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the index of the table.
+       *
+       * @param[in] table The table of names, which has to outlive the index;
+       *                  usually a `constexpr` variable
+       */
+      explicit StaticOptionIndex_(const Table& table);
+
+      /// Fields
+  private:
+      /// The names of the options
+      const Table& _table;
+      /// The records bound to each option
+      std::array<OptionRecord_, Table::options> _records{};
+
+      /// Methods
+  private:
+      _retpure bool bound(std::size_t option) const;
+  };
+
+  template<class Table>
+  inline StaticOptionIndex_<Table>::StaticOptionIndex_(const Table& table)
+          : _table(table) {}
+
+  template<class Table>
+  inline void StaticOptionIndex_<Table>::bind(std::size_t option, OptionRecord_ record) {
+      _records.at(option) = std::move(record);
+  }
+
+  template<class Table>
+  inline void StaticOptionIndex_<Table>::setPolicy(std::size_t option, CallbackPolicy policy) {
+      _records.at(option).policy = policy;
+  }
+
+  template<class Table>
+  inline std::size_t StaticOptionIndex_<Table>::find(std::string_view name) const {
+      auto option = _table.find(name);
+      return bound(option) ? option : npos;
+  }
+
+  template<class Table>
+  inline std::pair<std::size_t, std::size_t>
+  StaticOptionIndex_<Table>::findValuePrefix(std::string_view arg) const {
+      std::pair<std::size_t, std::size_t> found{npos, 0};
+      _table.prefixes(arg, [&](std::size_t option, std::size_t length) {
+        if (bound(option) && !_records[option].flag) {
+            found = {option, length};
+        }
+      });
+      return found;
+  }
+
+  template<class Table>
+  inline const OptionRecord_& StaticOptionIndex_<Table>::operator[](std::size_t i) const {
+      return _records[i];
+  }
+
+  template<class Table>
+  inline std::size_t StaticOptionIndex_<Table>::size() const {
+      return Table::options;
+  }
+
+  template<class Table>
+  inline bool StaticOptionIndex_<Table>::bound(std::size_t option) const {
+      return option != npos && static_cast<bool>(_records[option].exporter);
+  }
+}
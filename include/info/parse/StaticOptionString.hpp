@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "utils.hpp"
+
+namespace info::parse::detail {
+  /**
+   * The compile time counterpart of OptionString.
+   *
+   * Splits a string literal such as `"quiet|silent|q|s"`
+   * into its names during constant evaluation, prepending
+   * the dash to each of them, exactly like OptionString does,
+   * without allocating anything.
+   *
+   * The names are stored in the object itself, so a
+   * StaticOptionString is meant to be used as a temporary
+   * when building a StaticNameTable_, or as a `constexpr`
+   * variable.
+   *
+   * @tparam N The size of the string literal, including the
+   *           terminating null
+   *
+   * @note Empty strings such as `"opt||o"` are ignored.
+   *
+   * @see makeOptionTable()
+   */
+  template<std::size_t N>
+  class StaticOptionString {
+      /// Interface
+  public:
+      /// The most names a literal of this size can hold
+      static constexpr std::size_t capacity = N / 2;
+      /// The most characters the names take: each dash replaces a pipe, but the first
+      static constexpr std::size_t chars = N;
+
+      /**
+       * Returns the amount of names stored
+       */
+      _retpure constexpr std::size_t size() const;
+
+      /**
+       * Returns the i-th name, with one prepended dash
+       *
+       * @param[in] i The index of the name; not checked
+       * @return A view of the name, valid as long as this object is
+       */
+      _retpure constexpr std::string_view operator[](std::size_t i) const;
+
+      /**
+       * Return true if at least one of the
+       * names is a short-type parameter (-<char>)
+       */
+      _retpure constexpr bool hasShort() const;
+
+      /// Lifecycle
+  public:
+      /**
+       * Splits the literal into names by the pipe characters ('|')
+       * and prepends each with a dash, except for `<>`.
+       *
+       * @param[in] names The names string to be processed into names
+       */
+      constexpr StaticOptionString(const char (& names)[N]);
+
+      /// Fields
+  private:
+      /// The names one after the other
+      std::array<char, chars> _buffer{};
+      /// Where each name begins in _buffer
+      std::array<std::size_t, capacity> _offsets{};
+      /// The length of each name
+      std::array<std::size_t, capacity> _lengths{};
+      /// The amount of names stored
+      std::size_t _size = 0;
+  };
+
+  template<std::size_t N>
+  StaticOptionString(const char (&)[N]) -> StaticOptionString<N>;
+
+  template<std::size_t N>
+  constexpr StaticOptionString<N>::StaticOptionString(const char (& names)[N]) {
+      std::size_t length = 0;
+      std::size_t begin = 0;
+      for (std::size_t i = 0; i + 1 < N; ++i) {
+          if (names[i] == '|') {
+              begin = i + 1;
+              continue;
+          }
+          if (i == begin) {
+              _offsets[_size] = length;
+              _lengths[_size] = 0;
+              ++_size;
+              // <> is the only name without a dash
+              unless (names[i] == '<' && i + 2 < N && names[i + 1] == '>'
+                      && (i + 2 == N - 1 || names[i + 2] == '|')) {
+                  _buffer[length++] = '-';
+                  ++_lengths[_size - 1];
+              }
+          }
+          _buffer[length++] = names[i];
+          ++_lengths[_size - 1];
+      }
+  }
+
+  template<std::size_t N>
+  constexpr std::size_t StaticOptionString<N>::size() const {
+      return _size;
+  }
+
+  template<std::size_t N>
+  constexpr std::string_view StaticOptionString<N>::operator[](std::size_t i) const {
+      return std::string_view(_buffer.data() + _offsets[i], _lengths[i]);
+  }
+
+  template<std::size_t N>
+  constexpr bool StaticOptionString<N>::hasShort() const {
+      for (std::size_t i = 0; i < _size; ++i) {
+          if (_lengths[i] == 2)
+              return true;
+      }
+      return false;
+  }
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "Exporter_.hpp"
+#include "ParseSession_.hpp"
+#include "EventDispatch_.hpp"
+#include "StaticNameTable_.hpp"
+#include "StaticOptionIndex_.hpp"
+
+namespace info::parse {
+  /**
+   * Parses arguments with a set of options whose names
+   * are known at compile time.
+   *
+   * The names are given to makeOptionTable(), which builds a perfect
+   * hash table of them during compilation. The parser only binds
+   * the options of the table to variables or callbacks, so
+   * constructing it neither splits nor allocates anything for the names,
+   * and each name is looked up with one hash and one compare.
+   * Otherwise parsing is the same as with OptionsParser.
+   *
+   * @code
+   * constexpr auto options = info::parse::makeOptionTable("quiet|q", "output|o");
+   *
+   * bool quiet = false;
+   * std::string output;
+   * info::parse::StaticOptionsParser parser(options);
+   * parser.addOption(options.option("quiet"), &quiet)
+   *       .addOption(options.option("o"), &output);
+   * auto rest = parser.parse(argc, argv);
+   * @endcode
+   *
+   * @tparam Table The type of the table returned by makeOptionTable()
+   */
+  template<class Table>
+  class StaticOptionsParser {
+      /// Interface
+  public:
+      /**
+       * Binds the option of the table to a variable of type T,
+       * to be set while parsing.
+       *
+       * @tparam T Type for the exported value
+       * @param[in] option The index of the option in the table; the
+       *                   position of its literal in makeOptionTable()
+       * @param[out] exporter A pointer to a memory block of type T, into
+       *                      which the parsed value will be put
+       *
+       * @throws std::out_of_range if the table has no such option
+       *
+       * @see OptionsParser::addOption()
+       */
+      template<class T>
+      std::enable_if_t<std::is_function_v<T> || (detail::can_parse_v<T>
+                                                 && std::is_default_constructible_v<T>),
+              StaticOptionsParser&>
+      addOption(std::size_t option, T* exporter);
+
+      template<class R, class... Args>
+      StaticOptionsParser& addOption(std::size_t option,
+                                     detail::identity_t<const std::function<R(Args...)>&> f);
+
+      /**
+       * Sets how many times the callback bound to the option is
+       * called with each of its values. Binding the option again
+       * resets it to the default.
+       *
+       * @param[in] option The index of the option in the table
+       * @param[in] policy The policy to call the callback by
+       * @return A reference to this object to allow chain-calling
+       *
+       * @throws std::out_of_range if the table has no such option
+       *
+       * @see OptionsParser::withPolicy()
+       */
+      StaticOptionsParser& withPolicy(std::size_t option, CallbackPolicy policy);
+
+      /**
+       * Parses the given arguments using parameters in
+       * the style of `int main` parameters.
+       *
+       * @param[in] argc The length of argv
+       * @param[in] argv An array of char arrays which store the
+       *             parameters split up by the local shell
+       * @returns The arguments not belonging to any option, concatenated
+       *         as by makeMonolithArgs
+       *
+       * @see OptionsParser::parse(int, char**)
+       */
+      std::string parse(int argc, char** argv);
+
+      /**
+       * Parses the given arguments without copying them.
+       *
+       * @param[in] argc The length of argv
+       * @param[in] argv The arguments, which have to outlive rest
+       * @param[out] rest The arguments not belonging to any option
+       *                  are appended to this
+       *
+       * @see OptionsParser::parse(int, const char* const*, std::vector<std::string_view>&)
+       */
+      void parse(int argc, const char* const* argv, std::vector<std::string_view>& rest);
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs a parser for the options of the table
+       *
+       * @param[in] table The table of the options, which has to outlive
+       *                  the parser; usually a `constexpr` variable
+       */
+      explicit StaticOptionsParser(const Table& table);
+
+      /// Fields
+  private:
+      /// The names of the options and what is bound to them
+      detail::StaticOptionIndex_<Table> _index;
+      /// The used options of each nesting level, reused between parses
+      detail::EventBuffers_ _buffers;
+  };
+
+  template<class Table>
+  inline StaticOptionsParser<Table>::StaticOptionsParser(const Table& table)
+          : _index(table) {}
+
+  template<class Table>
+  template<class T>
+  inline std::enable_if_t<std::is_function_v<T> || (detail::can_parse_v<T>
+                                                    && std::is_default_constructible_v<T>),
+          StaticOptionsParser<Table>&>
+  StaticOptionsParser<Table>::addOption(std::size_t option, T* exporter) {
+      _index.bind(option, {detail::is_flag_v<T>, detail::Exporter_<T>(exporter)});
+      return *this;
+  }
+
+  template<class Table>
+  template<class R, class... Args>
+  inline StaticOptionsParser<Table>&
+  StaticOptionsParser<Table>::addOption(std::size_t option,
+                                        detail::identity_t<const std::function<R(Args...)>&> f) {
+      static_assert(sizeof...(Args) <= 2, "Supplied callback function takes too many arguments");
+      _index.bind(option, {false, detail::Exporter_<detail::none, R, Args...>(f)});
+      return *this;
+  }
+
+  template<class Table>
+  inline StaticOptionsParser<Table>&
+  StaticOptionsParser<Table>::withPolicy(std::size_t option, CallbackPolicy policy) {
+      _index.setPolicy(option, policy);
+      return *this;
+  }
+
+  template<class Table>
+  inline std::string StaticOptionsParser<Table>::parse(int argc, char** argv) {
+      std::vector<std::string_view> rest;
+      parse(argc, argv, rest);
+      return info::parse::makeMonolithArgs(rest);
+  }
+
+  template<class Table>
+  inline void StaticOptionsParser<Table>::parse(int argc, const char* const* argv,
+                                                std::vector<std::string_view>& rest) {
+      // callbacks are called while parsing, and may parse again
+      detail::EventBuffers_::Lease lease(_buffers);
+      detail::DispatchSink_ sink(_index, rest);
+      detail::ParseSession_ session(_index, sink, lease.used());
+      for (int i = 0; i < argc; ++i) {
+          session.feed(argv[i]);
+      }
+      session.finish();
+  }
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <string>
+#include <istream>
+#include <charconv>
+#include <streambuf>
+#include <string_view>
+#include <type_traits>
+#include <system_error>
+
+#include "utils.hpp"
+
+namespace info::parse {
+  namespace detail {
+    /**
+     * Read-only stream buffer over a string_view, so a value
+     * can be streamed from without copying it into a string first.
+     */
+    class ViewStreamBuf_ : public std::streambuf {
+        /// Lifecycle
+    public:
+        /**
+         * Constructs the buffer
+         *
+         * @param[in] view The characters to read; must outlive the buffer
+         */
+        explicit ViewStreamBuf_(std::string_view view) {
+            auto begin = const_cast<char*>(view.data());
+            setg(begin, begin, begin + view.size());
+        }
+    };
+
+    /**
+     * Converts the value using operator>>, as the library
+     * always did: the result is whatever operator>> makes of it.
+     *
+     * @param[in] value The raw value
+     * @param[out] out The object to stream into
+     * @return Whether operator>> succeeded
+     */
+    template<class T>
+    inline bool streamValue(std::string_view value, T& out) {
+        ViewStreamBuf_ buf(value);
+        std::istream is(&buf);
+        is >> out;
+        return !is.fail();
+    }
+
+    /**
+     * Whether T is an arithmetic type read as a number by operator>>,
+     * which excludes bool and the character types
+     */
+    template<class T>
+    inline constexpr bool is_number_v = std::is_arithmetic_v<T>
+                                        && !std::is_same_v<T, bool>
+                                        && !std::is_same_v<T, char>
+                                        && !std::is_same_v<T, signed char>
+                                        && !std::is_same_v<T, unsigned char>
+                                        && !std::is_same_v<T, wchar_t>
+                                        && !std::is_same_v<T, char16_t>
+                                        && !std::is_same_v<T, char32_t>;
+  }
+
+  /**
+   * Converts the raw string values found for options into
+   * the types of the variables and callback parameters.
+   *
+   * The primary template uses operator>>, so any type that can be
+   * streamed from an std::istream works. Numbers are converted with
+   * std::from_chars, strings are assigned directly. Whenever
+   * from_chars would disagree with operator>>, like on a leading
+   * `+`, whitespace or overflow, the value is streamed instead, so the
+   * results are exactly the ones operator>> gives, only faster.
+   *
+   * The point of customization for user types: specialize it
+   * with a static parse function to convert without streams,
+   * returning whether the value was valid. A specialization is
+   * preferred over operator>>, and types with a specialization
+   * need no operator>> to be used as options.
+   * @code
+   * template<>
+   * struct info::parse::ValueParser<Duration> {
+   *     static bool parse(std::string_view value, Duration& out) {
+   *         // ...
+   *     }
+   * };
+   * @endcode
+   *
+   * @tparam T The type to convert to
+   * @tparam Enable For partial specializations with SFINAE
+   */
+  template<class T, class Enable = void>
+  struct ValueParser {
+      /**
+       * Converts the value into out; only exists if T
+       * can be streamed from an std::istream
+       *
+       * @param[in] value The raw value; not empty
+       * @param[out] out The object to put the converted value into
+       * @return Whether the value was valid; out may be modified
+       *         either way
+       */
+      template<class U = T, class = std::enable_if_t<detail::can_stream_in_v<U>>>
+      static bool parse(std::string_view value, U& out) {
+          return detail::streamValue(value, out);
+      }
+  };
+
+  /**
+   * Integers and floating point numbers, through std::from_chars
+   */
+  template<class T>
+  struct ValueParser<T, std::enable_if_t<detail::is_number_v<T>>> {
+      static bool parse(std::string_view value, T& out) {
+          auto end = value.data() + value.size();
+          T parsed{};
+          auto[ptr, ec] = std::from_chars(value.data(), end, parsed);
+          bool agrees = ec == std::errc{};
+          if constexpr (std::is_floating_point_v<T>) {
+              // operator>> rejects inf and nan, and a dangling exponent
+              agrees = agrees && value[0] != 'i' && value[0] != 'n'
+                       && (value[0] != '-' || (value.size() > 1 && value[1] != 'i' && value[1] != 'n'))
+                       && (ptr == end || (*ptr != 'e' && *ptr != 'E'));
+          }
+          unless (agrees) {
+              return detail::streamValue(value, out);
+          }
+          out = parsed;
+          return true;
+      }
+  };
+
+  /**
+   * Booleans, which operator>> reads as 0 or 1
+   */
+  template<>
+  struct ValueParser<bool> {
+      static bool parse(std::string_view value, bool& out) {
+          if (value == "1" || value == "0") {
+              out = value[0] == '1';
+              return true;
+          }
+          return detail::streamValue(value, out);
+      }
+  };
+
+  /**
+   * Strings take the whole value, not only its first word
+   */
+  template<>
+  struct ValueParser<std::string> {
+      static bool parse(std::string_view value, std::string& out) {
+          out.assign(value.data(), value.size());
+          return true;
+      }
+  };
+
+  namespace detail {
+    /**
+     * Whether values of T can be converted by ValueParser<T>,
+     * either by a specialization, or by operator>>
+     */
+    template<class T, class = void>
+    struct can_parse : std::false_type {};
+
+    template<class T>
+    struct can_parse<T, std::void_t<decltype(ValueParser<T>::parse(std::declval<std::string_view>(),
+                                                                   std::declval<T&>()))>>
+            : std::true_type {};
+
+    /**
+     * Helper for can_parse<T>::value
+     *
+     * @see can_parse
+     */
+    template<class T>
+    inline constexpr bool can_parse_v = can_parse<T>::value;
+
+    /**
+     * Converts the value with ValueParser<T>; specializations
+     * returning nothing are taken to always succeed
+     *
+     * @param[in] value The raw value; not empty
+     * @param[out] out The object to put the converted value into
+     * @return Whether the value was valid
+     */
+    template<class T>
+    inline bool parseValue(std::string_view value, T& out) {
+        if constexpr (std::is_void_v<decltype(ValueParser<T>::parse(value, out))>) {
+            ValueParser<T>::parse(value, out);
+            return true;
+        } else {
+            return static_cast<bool>(ValueParser<T>::parse(value, out));
+        }
+    }
+  }
+}
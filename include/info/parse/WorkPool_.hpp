@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+#include "utils.hpp"
+
+namespace info::parse::detail {
+  /**
+   * Runs batches of independent work items on multiple threads.
+   *
+   * The items are split into one contiguous range for each worker.
+   * Workers take items from the front of their own range a grain
+   * at a time, through an atomic cursor, and once it is exhausted,
+   * they steal grains from the other ranges through the same cursors.
+   * So an uneven batch still keeps every worker busy until the
+   * whole batch is done, while most items are taken without
+   * contention.
+   *
+   * The helper threads are started with the pool and wait for
+   * batches until it is destructed, so a batch does not start
+   * any threads; the calling thread is one of the workers.
+   * The pool does one batch at a time: batches run from multiple
+   * threads at once take turns.
+   */
+  class WorkPool_ {
+      /// Interface
+  public:
+      /**
+       * The work to do, called as `work(worker, begin, end)` with the
+       * index of the worker doing it, and the range of items to do.
+       * A worker's calls never overlap, so the worker index can be used
+       * to pick buffers owned by the worker.
+       */
+      using Work = std::function<void(std::size_t, std::size_t, std::size_t)>;
+
+      /**
+       * Does the items of the batch, and returns once all are done.
+       *
+       * If the work throws, the first exception thrown is rethrown
+       * after all workers stopped; items not yet taken are not done.
+       *
+       * @param[in] items The amount of items in the batch
+       * @param[in] work The work to do with the items; it shall not
+       *                 run batches on the same pool
+       * @param[in] threads The most threads to use for this batch;
+       *                    0 means all threads of the pool
+       */
+      void run(std::size_t items, const Work& work, std::size_t threads = 0);
+
+      /**
+       * Returns the amount of workers used for a batch
+       * of that many items
+       *
+       * @param[in] items The amount of items in the batch
+       * @param[in] threads The most threads to use, as for run()
+       */
+      _retpure std::size_t workersFor(std::size_t items, std::size_t threads = 0) const;
+
+      /**
+       * Returns the pool shared by the whole process, with one
+       * thread for each hardware thread; started when first used
+       */
+      _retval static WorkPool_& shared();
+
+      /// Lifecycle
+  public:
+      /**
+       * Constructs the pool, starting its helper threads
+       *
+       * @param[in] threads The amount of threads to use, including
+       *                    the one running the batch; 0 means one
+       *                    for each hardware thread
+       * @param[in] grain The amount of items taken at once
+       */
+      explicit WorkPool_(std::size_t threads = 0, std::size_t grain = 64);
+
+      WorkPool_(const WorkPool_&) = delete;
+      WorkPool_& operator=(const WorkPool_&) = delete;
+
+      /**
+       * Stops and joins the helper threads
+       */
+      ~WorkPool_();
+
+      /// Fields
+  private:
+      struct Batch;
+
+      /// The amount of threads to use
+      std::size_t _threads;
+      /// The amount of items taken at once
+      std::size_t _grain;
+      /// Held while a batch is run, so batches take turns
+      std::mutex _running;
+      /// Guards the fields below
+      std::mutex _lock;
+      /// Notified when a batch is started, or the pool stops
+      std::condition_variable _started;
+      /// Notified when the last helper is done with the batch
+      std::condition_variable _finished;
+      /// The batch being run
+      Batch* _batch = nullptr;
+      /// The amount of batches started so far
+      std::size_t _generation = 0;
+      /// The helpers still working on the batch
+      std::size_t _busy = 0;
+      /// Whether the helpers are to stop
+      bool _stopping = false;
+      /// The helper threads; helper i is worker i + 1
+      std::vector<std::thread> _helpers;
+
+      /// Methods
+  private:
+      void help(std::size_t self);
+
+      void stop();
+  };
+}
@@ -13,9 +13,10 @@
 
 #include <vector>
 #include <string>
-#include <regex>
+#include <string_view>
 #include <sstream>
 #include <iterator>
+#include <functional>
 #include <unordered_map>
 
 #define unless(x) if (!(x))
@@ -52,34 +53,111 @@
 #endif
 
 namespace info::parse {
-  // guaranteed s = arcItrStr(itrStr(s))
-  // or whatever, you get it
+  /**
+   * Escapes the whitespace of the string, so it stays one argument when
+   * joined: `$` becomes `\$`, and each run of whitespace becomes `$n$`,
+   * n being the length of the run, which arcItrStr turns back.
+   * Whitespace is what std::regex's `\s` matches in the global locale.
+   *
+   * Done in one pass, and without allocating if nothing needs escaping.
+   *
+   * @param[in,out] str The string to escape
+   */
   void itrStr(std::string& str);
+  /**
+   * Undoes itrStr in one pass. As it always did, it leaves a `$n$` as is
+   * unless preceded by some character other than `\`, so leading
+   * whitespace, or whitespace right after a `\`, does not round-trip.
+   *
+   * @param[in,out] str The string to unescape
+   */
   void arcItrStr(std::string& str);
   void itrStr(std::wstring& str);
   void arcItrStr(std::wstring& str);
 
   _pure std::string makeMonolithArgs(int argc, char** argv);
+  _pure std::string makeMonolithArgs(const std::vector<std::string_view>& args);
+  /**
+   * Joins the arguments the same way makeMonolithArgs does, with
+   * a space before and after each, but without escaping anything,
+   * for arguments that are already escaped.
+   */
+  _pure std::string joinArgs(const std::vector<std::string_view>& args);
+  /**
+   * Appends one argument the way makeMonolithArgs joins it, escaped
+   * as by itrStr and followed by a space; arguments needing no escape
+   * are appended as they are, without looking at the locale.
+   *
+   * @param[in] arg The argument to append
+   * @param[out] out The string to append to
+   */
+  void appendMonolithArg(std::string_view arg, std::string& out);
 
   void replaceAll(std::string& str, const std::string& from, const std::string& to);
   void replaceAll(std::wstring& str, const std::wstring& from, const std::wstring& to);
 
-  template<class Traits, class CharT, class UnaryFunction>
-  _pure std::basic_string<CharT> regex_replace(const std::basic_string<CharT>& s,
-                                               const std::basic_regex<CharT, Traits>& re,
-                                               UnaryFunction f);
-
-  template<class BidirIt, class Traits, class CharT, class UnaryFunction>
-  _pure std::basic_string<CharT> regex_replace(BidirIt first, BidirIt last,
-                                               const std::basic_regex<CharT, Traits>& re,
-                                               UnaryFunction f);
-
   _pure std::vector<std::string> split(const std::string& toSplit, char c);
 
   _pure bool anyOf(char c, const std::string& set);
 
   void to_lower(std::string& str);
 
+  /**
+   * Evaluates the truthyness of a value supplied to a boolean flag
+   * according to the parsing rules:
+   *  - the literals `yes` & `true` are true, `no` & `false` are false,
+   *    case insensitively
+   *  - values beginning with a digit are true unless the number they
+   *    begin with is zero
+   *  - anything else is true unless it is empty or consists only of
+   *    whitespace
+   *
+   * @param[in] val The value to evaluate
+   * @return The truthyness of the value
+   */
+  _pure bool isTruthy(std::string_view val);
+
+  /**
+   * Replaces each run of whitespace in the input with one space,
+   * the same as `std::regex_replace(in, std::regex("\\s+"), " ")`
+   * does, whitespace being the characters `" \t\n\v\f\r"`, and the
+   * bytes of 0x80 and above the global locale's ctype deems space.
+   * Other ASCII characters are not whitespace, even if the locale
+   * says otherwise.
+   *
+   * The work is done 32 or 16 bytes at a time with AVX2 or SSE2,
+   * whichever the processor supports, or one byte at a time
+   * if neither, or if INFO_NO_SIMD is defined. Blocks containing
+   * bytes of 0x80 and above are done one byte at a time.
+   *
+   * @param[in] in The string to collapse; may not view out
+   * @param[out] out The string to write into; its contents are
+   *                 replaced, but its storage is reused if large enough
+   */
+  void collapseWhitespace(std::string_view in, std::string& out);
+
+  /**
+   * Explodes the bundles of short flags in a string of arguments,
+   * so `" -abc "` becomes `" -a  -b   -c   "`, in one pass.
+   *
+   * A bundle is a `" -"` followed by anything but a dash or a space,
+   * up to the next space; dashes inside the bundle are dropped.
+   * Each flag of the bundle becomes `" -x "`, with one more space after
+   * every flag but the first, and a `" -"` at the very end is dropped,
+   * the same as the string parser always did.
+   * The `" -"` sequences are searched for with SSE2 or AVX2 like
+   * in collapseWhitespace.
+   *
+   * @param[in] in The arguments; may not view out
+   * @param[out] out The string to write into; its contents are
+   *                 replaced, but its storage is reused if large enough
+   * @param[in] isName Tells whether a bundle, with its dash, names an
+   *                   option instead, like `-quiet`; those are kept
+   *                   whole. If empty, every bundle is exploded.
+   */
+  void explodeBundles(std::string_view in, std::string& out,
+                      const std::function<bool(std::string_view)>& isName = {});
+
   namespace detail {
     struct none {
         friend std::istream& operator>>(std::istream& is, const none& none) {
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <stdexcept>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(ArgFrame.hpp)
+
+namespace {
+  void appendVarint(std::uint64_t value, std::string& out) {
+      while (value >= 0x80) {
+          out += static_cast<char>((value & 0x7F) | 0x80);
+          value >>= 7;
+      }
+      out += static_cast<char>(value);
+  }
+
+  std::size_t varintSize(std::uint64_t value) {
+      std::size_t size = 1;
+      while (value >= 0x80) {
+          value >>= 7;
+          ++size;
+      }
+      return size;
+  }
+
+  template<class It>
+  void encode(It begin, It end, std::string& out) {
+      std::size_t size = varintSize(static_cast<std::uint64_t>(end - begin));
+      for (auto it = begin; it != end; ++it) {
+          std::string_view arg(*it);
+          size += varintSize(arg.size()) + arg.size();
+      }
+      out.reserve(out.size() + size);
+      appendVarint(static_cast<std::uint64_t>(end - begin), out);
+      for (auto it = begin; it != end; ++it) {
+          std::string_view arg(*it);
+          appendVarint(arg.size(), out);
+          out.append(arg.data(), arg.size());
+      }
+  }
+}
+
+void info::parse::encodeArgs(const std::vector<std::string_view>& args, std::string& out) {
+    encode(args.begin(), args.end(), out);
+}
+
+void info::parse::encodeArgs(int argc, const char* const* argv, std::string& out) {
+    encode(argv, argv + argc, out);
+}
+
+std::size_t info::parse::decodeArgs(std::string_view frames, std::vector<std::string_view>& args) {
+    detail::ArgFrameReader_ reader(frames);
+    std::string_view arg;
+    while (reader.next(arg)) {
+        args.push_back(arg);
+    }
+    return reader.consumed();
+}
+
+info::parse::detail::ArgFrameReader_::ArgFrameReader_(std::string_view frames)
+        : _frames(frames),
+          _left(readVarint()) {
+    // the whole frame is checked first, so nothing is read from a bad one
+    auto first = _pos;
+    for (auto left = _left; left; --left) {
+        auto size = readVarint();
+        if (size > _frames.size() - _pos)
+            throw std::invalid_argument("Argument frame is truncated: argument longer than the data left");
+        _pos += static_cast<std::size_t>(size);
+    }
+    _pos = first;
+}
+
+bool info::parse::detail::ArgFrameReader_::next(std::string_view& arg) {
+    unless (_left) {
+        return false;
+    }
+    auto size = readVarint();
+    arg = _frames.substr(_pos, static_cast<std::size_t>(size));
+    _pos += static_cast<std::size_t>(size);
+    --_left;
+    return true;
+}
+
+std::size_t info::parse::detail::ArgFrameReader_::consumed() const {
+    return _pos;
+}
+
+std::uint64_t info::parse::detail::ArgFrameReader_::readVarint() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (_pos == _frames.size())
+            throw std::invalid_argument("Argument frame is truncated: unfinished length");
+        auto byte = static_cast<unsigned char>(_frames[_pos++]);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        unless (byte & 0x80) {
+            return value;
+        }
+    }
+    throw std::invalid_argument("Argument frame is malformed: length longer than 64 bits");
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <cstring>
+#include <utility>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(CmdlineCorpus.hpp)
+
+info::parse::CmdlineCorpus::CmdlineCorpus(const std::string& path)
+        : _file(path) {}
+
+info::parse::CmdlineCorpus::CmdlineCorpus(detail::MappedFile_ file)
+        : _file(std::move(file)) {}
+
+info::parse::CmdlineCorpus info::parse::CmdlineCorpus::inMemory(std::string_view data) {
+    return CmdlineCorpus(detail::MappedFile_::view(data));
+}
+
+bool info::parse::CmdlineCorpus::next(std::string_view& record) {
+    auto corpus = _file.data();
+    auto data = corpus.data();
+    auto size = corpus.size();
+    // empty records
+    while (_pos < size && data[_pos] == '\0') {
+        ++_pos;
+    }
+    if (_pos == size)
+        return false;
+
+    auto begin = _pos;
+    for (;;) {
+        auto nul = static_cast<const char*>(std::memchr(data + _pos, '\0', size - _pos));
+        if (nul == nullptr) {
+            _pos = size;
+            break;
+        }
+        _pos = static_cast<std::size_t>(nul - data) + 1;
+        // the NUL ending the last argument, followed by the one ending the record
+        if (_pos == size || data[_pos] == '\0') {
+            record = corpus.substr(begin, _pos - begin);
+            _pos += _pos < size;
+            return true;
+        }
+    }
+    record = corpus.substr(begin, _pos - begin);
+    return true;
+}
+
+bool info::parse::CmdlineCorpus::next(std::vector<std::string_view>& args) {
+    args.clear();
+    std::string_view record;
+    unless (next(record)) {
+        return false;
+    }
+    auto pos = record.data();
+    auto end = pos + record.size();
+    while (pos != end) {
+        auto nul = static_cast<const char*>(std::memchr(pos, '\0', static_cast<std::size_t>(end - pos)));
+        auto argEnd = nul ? nul : end;
+        args.emplace_back(pos, static_cast<std::size_t>(argEnd - pos));
+        pos = nul ? nul + 1 : end;
+    }
+    return true;
+}
+
+void info::parse::CmdlineCorpus::rewind() {
+    _pos = 0;
+}
+
+std::string_view info::parse::CmdlineCorpus::data() const {
+    return _file.data();
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(CompiledParser.hpp)
+#include INFO_PARSE_INCLUDE(ArgFrame.hpp)
+
+namespace {
+  /// One set of buffers for each thread, reused by all parses on it
+  info::parse::detail::StringScratch_& threadScratch() {
+      thread_local info::parse::detail::StringScratch_ scratch;
+      return scratch;
+  }
+}
+
+info::parse::CompiledParser::CompiledParser(const detail::OptionIndex_& index)
+        : _index(std::make_shared<const detail::OptionIndex_>(index)) {}
+
+info::parse::ParseResult info::parse::CompiledParser::parse(std::string_view args) const {
+    ParseResult result;
+    parse(args, result);
+    return result;
+}
+
+void info::parse::CompiledParser::parse(std::string_view args, ParseResult& result) const {
+    detail::RecordingSink_ sink(result, false);
+    auto& scratch = threadScratch();
+    detail::ParseSession_ session(*_index, sink, scratch.used);
+    detail::feedString(args, scratch, session);
+    session.finish();
+}
+
+info::parse::ParseResult info::parse::CompiledParser::parse(int argc, const char* const* argv) const {
+    ParseResult result;
+    parse(argc, argv, result);
+    return result;
+}
+
+void info::parse::CompiledParser::parse(int argc, const char* const* argv,
+                                        ParseResult& result) const {
+    detail::RecordingSink_ sink(result, true);
+    detail::ParseSession_ session(*_index, sink, threadScratch().used);
+    for (int i = 0; i < argc; ++i) {
+        session.feed(argv[i]);
+    }
+    session.finish();
+}
+
+void info::parse::CompiledParser::parse(const std::vector<std::string_view>& args,
+                                        ParseResult& result) const {
+    detail::RecordingSink_ sink(result, true);
+    detail::ParseSession_ session(*_index, sink, threadScratch().used);
+    for (auto&& arg : args) {
+        session.feed(arg);
+    }
+    session.finish();
+}
+
+std::size_t info::parse::CompiledParser::parseFrame(std::string_view frames,
+                                                   ParseResult& result) const {
+    detail::RecordingSink_ sink(result, true);
+    detail::ParseSession_ session(*_index, sink, threadScratch().used);
+    detail::ArgFrameReader_ reader(frames);
+    std::string_view arg;
+    while (reader.next(arg)) {
+        session.feed(arg);
+    }
+    session.finish();
+    return reader.consumed();
+}
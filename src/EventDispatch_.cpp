@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <mutex>
+#include <utility>
+#include <exception>
+#include <condition_variable>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(EventDispatch_.hpp)
+
+namespace {
+  /**
+   * Waits for the tasks submitted to an executor,
+   * and keeps the first exception they throw.
+   */
+  class Barrier {
+      /// Interface
+  public:
+      /// Called before submitting a task
+      void add() {
+          std::lock_guard<std::mutex> lock(_lock);
+          ++_pending;
+      }
+
+      /// Called by a task when done, with the exception it threw, if any
+      void done(std::exception_ptr error) {
+          std::lock_guard<std::mutex> lock(_lock);
+          if (error && !_error)
+              _error = error;
+          unless (--_pending) {
+              _allDone.notify_all();
+          }
+      }
+
+      /// Waits for all tasks submitted so far
+      void wait() {
+          std::unique_lock<std::mutex> lock(_lock);
+          _allDone.wait(lock, [this] { return _pending == 0; });
+      }
+
+      /// Rethrows the first exception of a task, if any
+      void rethrow() {
+          if (_error)
+              std::rethrow_exception(std::exchange(_error, nullptr));
+      }
+
+      /// Fields
+  private:
+      std::mutex _lock;
+      std::condition_variable _allDone;
+      std::size_t _pending = 0;
+      std::exception_ptr _error;
+  };
+}
+
+void info::parse::detail::dispatchEvents(const OptionIndex_& index,
+                                         const std::vector<ParseEvent_>& events,
+                                         const Executor& executor) {
+    unless (executor) {
+        for (auto&& event : events) {
+            index[event.option].accept(event.value);
+        }
+        return;
+    }
+
+    Barrier barrier;
+    bool submitted = false;
+    auto drain = [&] {
+      if (submitted) {
+          barrier.wait();
+          submitted = false;
+          barrier.rethrow();
+      }
+    };
+
+    try {
+        for (auto&& event : events) {
+            auto& record = index[event.option];
+            unless (record.independent) {
+                drain();
+                record.accept(event.value);
+                continue;
+            }
+            barrier.add();
+            submitted = true;
+            try {
+                executor([&barrier, &record, value = event.value] {
+                  try {
+                      record.accept(value);
+                      barrier.done(nullptr);
+                  } catch (...) {
+                      barrier.done(std::current_exception());
+                  }
+                });
+            } catch (...) {
+                barrier.done(nullptr); // never submitted
+                throw;
+            }
+        }
+        drain();
+    } catch (...) {
+        // tasks refer to the barrier; let them finish before leaving
+        barrier.wait();
+        throw;
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <system_error>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(MappedFile_.hpp)
+
+#if defined(__unix__) || defined(__APPLE__)
+  #define INFO_PARSE_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#else
+  #include <fstream>
+  #include <iterator>
+#endif
+
+namespace {
+  [[noreturn]] void fail(const std::string& what, const std::string& path) {
+      throw std::system_error(errno, std::generic_category(), what + " " + path);
+  }
+}
+
+info::parse::detail::MappedFile_::MappedFile_(const std::string& path) {
+#ifdef INFO_PARSE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        fail("Cannot open", path);
+    struct stat info{};
+    if (::fstat(fd, &info) < 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        fail("Cannot stat", path);
+    }
+
+    auto size = static_cast<std::size_t>(info.st_size);
+    if (size > 0) {
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            fail("Cannot map", path);
+        }
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+        _mapping = mapping;
+        _data = std::string_view(static_cast<const char*>(mapping), size);
+    } else {
+        // files like /proc/<pid>/cmdline claim to be empty until read
+        std::string contents;
+        char chunk[4096];
+        ssize_t read;
+        while ((read = ::read(fd, chunk, sizeof chunk)) != 0) {
+            if (read < 0) {
+                if (errno == EINTR)
+                    continue;
+                int error = errno;
+                ::close(fd);
+                errno = error;
+                fail("Cannot read", path);
+            }
+            contents.append(chunk, static_cast<std::size_t>(read));
+        }
+        assign(contents);
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    unless (file) {
+        fail("Cannot open", path);
+    }
+    std::string contents(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>{});
+    assign(contents);
+#endif
+}
+
+info::parse::detail::MappedFile_ info::parse::detail::MappedFile_::view(std::string_view data) {
+    MappedFile_ file;
+    file._data = data;
+    return file;
+}
+
+info::parse::detail::MappedFile_ info::parse::detail::MappedFile_::copy(std::string_view data) {
+    MappedFile_ file;
+    file.assign(data);
+    return file;
+}
+
+info::parse::detail::MappedFile_::MappedFile_(MappedFile_&& other) noexcept {
+    *this = std::move(other);
+}
+
+info::parse::detail::MappedFile_&
+info::parse::detail::MappedFile_::operator=(MappedFile_&& other) noexcept {
+    if (this != &other) {
+        release();
+        _data = std::exchange(other._data, {});
+        _mapping = std::exchange(other._mapping, nullptr);
+        _buffer = std::move(other._buffer);
+    }
+    return *this;
+}
+
+info::parse::detail::MappedFile_::~MappedFile_() {
+    release();
+}
+
+void info::parse::detail::MappedFile_::assign(std::string_view data) {
+    // new[] aligns for any fundamental type
+    _buffer.reset(new char[data.size()]);
+    unless (data.empty()) {
+        std::memcpy(_buffer.get(), data.data(), data.size());
+    }
+    _data = std::string_view(_buffer.get(), data.size());
+}
+
+void info::parse::detail::MappedFile_::release() noexcept {
+#ifdef INFO_PARSE_MMAP
+    if (_mapping) {
+        ::munmap(_mapping, _data.size());
+    }
+#endif
+    _mapping = nullptr;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(NameArena_.hpp)
+
+std::string_view info::parse::detail::NameArena_::store(std::string_view text) {
+    std::lock_guard lock(_mutex);
+    if (auto found = _texts.find(text); found != _texts.end())
+        return *found;
+
+    auto block = allocate(text.size(), 1);
+    unless (text.empty()) {
+        std::memcpy(block, text.data(), text.size());
+    }
+    std::string_view stored(block, text.size());
+    _texts.insert(stored);
+    return stored;
+}
+
+char* info::parse::detail::NameArena_::allocate(std::size_t size, std::size_t alignment) {
+    auto padding = (alignment - reinterpret_cast<std::uintptr_t>(_free) % alignment) % alignment;
+    if (_free == nullptr || padding + size > _left) {
+        // new[] aligns for any fundamental type
+        auto chunk = std::max(size, chunkSize);
+        _chunks.emplace_back(new char[chunk]);
+        _free = _chunks.back().get();
+        _left = chunk;
+        padding = 0;
+    }
+    auto block = _free + padding;
+    _free += padding + size;
+    _left -= padding + size;
+    return block;
+}
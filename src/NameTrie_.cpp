@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <map>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(NameTrie_.hpp)
+
+void info::parse::detail::NameTrie_::build(const std::vector<std::pair<std::string_view, std::size_t>>& names) {
+    // The trie is built with maps first, then flattened
+    std::vector<std::map<char, std::uint32_t>> children(1);
+    std::vector<std::vector<std::uint32_t>> owners(1);
+    std::vector<std::uint32_t> depths{0};
+
+    for (auto&&[name, owner] : names) {
+        std::uint32_t state = root;
+        for (char c : name) {
+            auto it = children[state].find(c);
+            if (it != children[state].end()) {
+                state = it->second;
+                continue;
+            }
+            auto next = static_cast<std::uint32_t>(children.size());
+            children[state].emplace(c, next);
+            children.emplace_back();
+            owners.emplace_back();
+            depths.push_back(depths[state] + 1);
+            state = next;
+        }
+        if (state != root) {
+            owners[state].push_back(static_cast<std::uint32_t>(owner));
+        }
+    }
+
+    _states.assign(children.size(), State{0, 0, 0, 0, 0});
+    _edges.clear();
+    _owners.clear();
+    for (std::uint32_t s = 0; s < children.size(); ++s) {
+        auto& state = _states[s];
+        state.depth = depths[s];
+        state.firstEdge = static_cast<std::uint32_t>(_edges.size());
+        state.edgeCount = static_cast<std::uint32_t>(children[s].size());
+        for (auto&&[c, target] : children[s]) {
+            _edges.push_back({c, target});
+        }
+        state.firstOwner = static_cast<std::uint32_t>(_owners.size());
+        state.ownerCount = static_cast<std::uint32_t>(owners[s].size());
+        _owners.insert(_owners.end(), owners[s].begin(), owners[s].end());
+    }
+    own();
+}
+
+std::uint32_t info::parse::detail::NameTrie_::step(std::uint32_t state, char c) const {
+    auto&& s = _stateData[state];
+    auto first = _edgeData + s.firstEdge;
+    auto last = first + s.edgeCount;
+    auto it = std::lower_bound(first, last, c, [](const Edge& edge, char ch) {
+      return edge.c < ch;
+    });
+    if (it == last || it->c != c)
+        return none;
+    return it->target;
+}
+
+std::pair<const std::uint32_t*, const std::uint32_t*>
+info::parse::detail::NameTrie_::owners(std::uint32_t state) const {
+    auto&& s = _stateData[state];
+    auto first = _ownerData + s.firstOwner;
+    return {first, first + s.ownerCount};
+}
+
+namespace {
+  template<class T>
+  void append(std::string& image, const T& value) {
+      image.append(reinterpret_cast<const char*>(&value), sizeof value);
+  }
+
+  [[noreturn]] void malformed(const char* what) {
+      throw std::invalid_argument(std::string("Malformed option image: ") + what);
+  }
+}
+
+void info::parse::detail::NameTrie_::save(std::string& image) const {
+    static_assert(sizeof(State) == 5 * sizeof(std::uint32_t) && sizeof(Edge) == 2 * sizeof(std::uint32_t),
+                  "The arrays are saved as they are in memory");
+    append(image, _stateCount);
+    append(image, _edgeCount);
+    append(image, _ownerCount);
+    image.append(reinterpret_cast<const char*>(_stateData), _stateCount * sizeof(State));
+    for (std::uint32_t e = 0; e < _edgeCount; ++e) {
+        // without the garbage in the padding
+        Edge edge;
+        std::memset(&edge, 0, sizeof edge);
+        edge.c = _edgeData[e].c;
+        edge.target = _edgeData[e].target;
+        append(image, edge);
+    }
+    image.append(reinterpret_cast<const char*>(_ownerData), _ownerCount * sizeof(std::uint32_t));
+}
+
+std::size_t info::parse::detail::NameTrie_::attach(std::string_view image, std::size_t optionCount) {
+    if (reinterpret_cast<std::uintptr_t>(image.data()) % alignof(std::uint32_t) != 0)
+        malformed("misaligned");
+    std::uint32_t counts[3];
+    if (image.size() < sizeof counts)
+        malformed("truncated");
+    std::memcpy(counts, image.data(), sizeof counts);
+    auto[states, edges, owners] = counts;
+    std::uint64_t size = sizeof counts
+                         + std::uint64_t(states) * sizeof(State)
+                         + std::uint64_t(edges) * sizeof(Edge)
+                         + std::uint64_t(owners) * sizeof(std::uint32_t);
+    if (image.size() < size)
+        malformed("truncated");
+    if (states == 0)
+        malformed("no root");
+    // every option owns a name, so there are no more options than owners
+    if (optionCount > owners)
+        malformed("more options than names");
+
+    auto stateData = reinterpret_cast<const State*>(image.data() + sizeof counts);
+    auto edgeData = reinterpret_cast<const Edge*>(stateData + states);
+    auto ownerData = reinterpret_cast<const std::uint32_t*>(edgeData + edges);
+    // edges only ever leading one deeper keeps names() from looping
+    if (stateData[root].depth != 0)
+        malformed("deep root");
+    for (std::uint32_t s = 0; s < states; ++s) {
+        auto&& state = stateData[s];
+        if (std::uint64_t(state.firstEdge) + state.edgeCount > edges
+            || std::uint64_t(state.firstOwner) + state.ownerCount > owners)
+            malformed("state out of range");
+        for (auto e = state.firstEdge; e < state.firstEdge + state.edgeCount; ++e) {
+            auto target = edgeData[e].target;
+            if (target >= states || stateData[target].depth != state.depth + 1)
+                malformed("edge out of range");
+        }
+    }
+
+    for (std::uint32_t o = 0; o < owners; ++o) {
+        if (ownerData[o] >= optionCount)
+            malformed("owner out of range");
+    }
+
+    _states.clear();
+    _edges.clear();
+    _owners.clear();
+    _stateData = stateData;
+    _edgeData = edgeData;
+    _ownerData = ownerData;
+    _stateCount = states;
+    _edgeCount = edges;
+    _ownerCount = owners;
+    return static_cast<std::size_t>(size);
+}
+
+void info::parse::detail::NameTrie_::names(std::vector<std::pair<std::string, std::size_t>>& names) const {
+    std::string name;
+    // depth first, with the edge to take next of each state on the way
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> path{{root, 0}};
+    while (!path.empty()) {
+        auto&[state, next] = path.back();
+        auto&& s = _stateData[state];
+        if (next == 0) {
+            for (auto o = s.firstOwner; o < s.firstOwner + s.ownerCount; ++o) {
+                names.emplace_back(name, _ownerData[o]);
+            }
+        }
+        if (next == s.edgeCount) {
+            path.pop_back();
+            unless (name.empty()) {
+                name.pop_back();
+            }
+            continue;
+        }
+        auto&& edge = _edgeData[s.firstEdge + next++];
+        name += edge.c;
+        path.emplace_back(edge.target, 0);
+    }
+}
+
+info::parse::detail::NameTrie_::NameTrie_() {
+    own();
+}
+
+info::parse::detail::NameTrie_::NameTrie_(const NameTrie_& other) {
+    *this = other;
+}
+
+info::parse::detail::NameTrie_&
+info::parse::detail::NameTrie_::operator=(const NameTrie_& other) {
+    if (this != &other) {
+        _states = other._states;
+        _edges = other._edges;
+        _owners = other._owners;
+        _stateData = other._stateData;
+        _edgeData = other._edgeData;
+        _ownerData = other._ownerData;
+        _stateCount = other._stateCount;
+        _edgeCount = other._edgeCount;
+        _ownerCount = other._ownerCount;
+        // an attached trie has no states of its own
+        unless (_states.empty()) {
+            own();
+        }
+    }
+    return *this;
+}
+
+info::parse::detail::NameTrie_::NameTrie_(NameTrie_&& other) noexcept {
+    *this = std::move(other);
+}
+
+info::parse::detail::NameTrie_&
+info::parse::detail::NameTrie_::operator=(NameTrie_&& other) noexcept {
+    if (this != &other) {
+        // moving vectors keeps their memory, and so the pointers valid
+        _states = std::move(other._states);
+        _edges = std::move(other._edges);
+        _owners = std::move(other._owners);
+        _stateData = other._stateData;
+        _edgeData = other._edgeData;
+        _ownerData = other._ownerData;
+        _stateCount = other._stateCount;
+        _edgeCount = other._edgeCount;
+        _ownerCount = other._ownerCount;
+        // left with only a root, which does not need allocating
+        static const State emptyRoot{0, 0, 0, 0, 0};
+        other._stateData = &emptyRoot;
+        other._stateCount = 1;
+        other._edgeCount = other._ownerCount = 0;
+    }
+    return *this;
+}
+
+void info::parse::detail::NameTrie_::own() {
+    _stateData = _states.data();
+    _edgeData = _edges.data();
+    _ownerData = _owners.data();
+    _stateCount = static_cast<std::uint32_t>(_states.size());
+    _edgeCount = static_cast<std::uint32_t>(_edges.size());
+    _ownerCount = static_cast<std::uint32_t>(_owners.size());
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(OptionImage.hpp)
+
+std::string info::parse::OptionImage::build(const std::vector<std::string>& options) {
+    detail::OptionIndex_ index;
+    for (auto&& names : options) {
+        detail::OptionString string(names);
+        // attach() relies on every option owning a name
+        auto&& all = string.getNames();
+        if (std::all_of(all.begin(), all.end(), [](auto&& name) { return name == "-"; }))
+            throw std::invalid_argument("Option has no name: \"" + names + "\"");
+        index.addOption(string, false, {});
+    }
+    index.freeze();
+    std::string image;
+    index.save(image);
+    return image;
+}
+
+info::parse::OptionImage::OptionImage(const std::string& path)
+        : OptionImage(detail::MappedFile_(path)) {}
+
+info::parse::OptionImage::OptionImage(detail::MappedFile_ file)
+        : _file(std::move(file)) {
+    _index.attach(_file.data());
+}
+
+info::parse::OptionImage info::parse::OptionImage::inMemory(std::string_view image) {
+    if (reinterpret_cast<std::uintptr_t>(image.data()) % alignof(std::uint32_t) != 0)
+        return OptionImage(detail::MappedFile_::copy(image));
+    return OptionImage(detail::MappedFile_::view(image));
+}
+
+std::size_t info::parse::OptionImage::option(std::string_view name) const {
+    auto option = _index.owner(name == "<>" ? "" : "-", name);
+    if (option == detail::OptionIndex_::npos)
+        throw std::out_of_range("No option is named " + std::string(name));
+    return option;
+}
+
+std::size_t info::parse::OptionImage::size() const {
+    return _index.size();
+}
+
+std::string_view info::parse::OptionImage::data() const {
+    return _file.data();
+}
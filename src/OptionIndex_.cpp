@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(OptionIndex_.hpp)
+
+namespace {
+  /// The start of an image; anything that differs between machines
+  /// the arrays of the trie would be read differently on is in it
+  struct ImageHeader {
+      char magic[8];
+      std::uint32_t format;
+      std::uint32_t byteOrder;
+      std::uint32_t charIsSigned;
+      std::uint32_t options;
+  };
+
+  constexpr ImageHeader currentHeader(std::uint32_t options) {
+      return {{'i', 'n', 'f', 'o', 'i', 'd', 'x', '\0'}, 2, 0x01020304u,
+              std::is_signed_v<char>, options};
+  }
+}
+
+void info::parse::detail::OptionIndex_::addOption(const OptionString& names, bool flag,
+                                                  InlineFunction_<void(std::string_view, const CallbackPolicy&)> accept) {
+    unless (_arena) {
+        _arena = std::make_shared<NameArena_>();
+    }
+    if (_attached) {
+        std::vector<std::pair<std::string, std::size_t>> imaged;
+        _trie.names(imaged);
+        for (auto&&[name, option] : imaged) {
+            _names.emplace_back(_arena->store(name), option);
+        }
+        _attached = false;
+    }
+    _records.push_back({flag, std::move(accept)});
+    for (auto&& name : names.getNames()) {
+        // an empty name, as in "quiet||q", is only its dash; indexing
+        // it would make a lone "-", which usually means stdin, an option
+        unless (name.empty() || name == "-") {
+            _names.emplace_back(_arena->store(name), _records.size() - 1);
+        }
+    }
+    _frozen = false;
+    ++_version;
+}
+
+void info::parse::detail::OptionIndex_::bind(std::size_t option, bool flag,
+                                             InlineFunction_<void(std::string_view, const CallbackPolicy&)> accept) {
+    auto& record = _records.at(option);
+    record.flag = flag;
+    record.exporter = std::move(accept);
+    ++_version;
+}
+
+void info::parse::detail::OptionIndex_::markIndependent(std::size_t option) {
+    _records.at(option).independent = true;
+}
+
+void info::parse::detail::OptionIndex_::setPolicy(std::size_t option, CallbackPolicy policy) {
+    _records.at(option).policy = policy;
+}
+
+void info::parse::detail::OptionIndex_::freeze() {
+    unless (_frozen) {
+        _trie.build(_names);
+        _frozen = true;
+    }
+}
+
+void info::parse::detail::OptionIndex_::save(std::string& image) const {
+    auto header = currentHeader(static_cast<std::uint32_t>(_records.size()));
+    image.append(reinterpret_cast<const char*>(&header), sizeof header);
+    _trie.save(image);
+}
+
+void info::parse::detail::OptionIndex_::attach(std::string_view image) {
+    ImageHeader header;
+    if (image.size() < sizeof header)
+        throw std::invalid_argument("Malformed option image: truncated");
+    std::memcpy(&header, image.data(), sizeof header);
+    auto expected = currentHeader(header.options);
+    if (std::memcmp(&header, &expected, sizeof header) != 0)
+        throw std::invalid_argument("Not an option image of this version, or of this machine");
+    _trie.attach(image.substr(sizeof header), header.options);
+    _records.assign(header.options, OptionRecord_{});
+    _names.clear();
+    _arena.reset();
+    _frozen = true;
+    _attached = true;
+    ++_version;
+}
+
+std::size_t info::parse::detail::OptionIndex_::find(std::string_view name) const {
+    auto option = owner(name);
+    return bound(option) ? option : npos;
+}
+
+std::size_t info::parse::detail::OptionIndex_::owner(std::string_view name) const {
+    return owner({}, name);
+}
+
+std::size_t info::parse::detail::OptionIndex_::owner(std::string_view prefix, std::string_view rest) const {
+    auto state = NameTrie_::root;
+    for (auto part : {prefix, rest}) {
+        for (char c : part) {
+            state = _trie.step(state, c);
+            if (state == NameTrie_::none)
+                return npos;
+        }
+    }
+    // If a name is taken by multiple options, the first one has it
+    auto[first, last] = _trie.owners(state);
+    if (first == last)
+        return npos;
+    return *first;
+}
+
+std::pair<std::size_t, std::size_t>
+info::parse::detail::OptionIndex_::findValuePrefix(std::string_view arg) const {
+    std::pair<std::size_t, std::size_t> found{npos, 0};
+    auto state = NameTrie_::root;
+    for (std::size_t len = 0; len + 1 < arg.size(); ++len) {
+        state = _trie.step(state, arg[len]);
+        if (state == NameTrie_::none)
+            break;
+        auto[first, last] = _trie.owners(state);
+        if (first != last && bound(*first) && !_records[*first].flag) {
+            found = {*first, len + 1};
+        }
+    }
+    return found;
+}
+
+const info::parse::detail::OptionRecord_&
+info::parse::detail::OptionIndex_::operator[](std::size_t i) const {
+    return _records[i];
+}
+
+std::size_t info::parse::detail::OptionIndex_::size() const {
+    return _records.size();
+}
+
+std::size_t info::parse::detail::OptionIndex_::version() const {
+    return _version;
+}
+
+bool info::parse::detail::OptionIndex_::bound(std::size_t option) const {
+    return option != npos && static_cast<bool>(_records[option].exporter);
+}
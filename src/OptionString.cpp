@@ -2,50 +2,67 @@
 // Created by bodand on 2019-07-24.
 //
 
+#include <new>
+#include <cstring>
+#include <algorithm>
+
 #include "include.hpp"
 #include INFO_PARSE_INCLUDE(OptionString.hpp)
 #include INFO_PARSE_INCLUDE(utils.hpp)
 
-info::parse::detail::OptionString::OptionString(const std::string& str)
-        : _names(OptionString::prependDashes(info::parse::split(str, '|'))) {
-    for (auto&& name : _names) {
-        _kmpSearch.emplace_back([](/*const */std::string& name) {
-          return std::make_shared<FinderEins<char>>(name.begin(), name.end());
-        });
-        _bmSearch.emplace_back([](/*const */std::string& name) {
-          return std::make_shared<FinderZwei<char>>(name.begin(), name.end());
-        });
+info::parse::detail::OptionString::OptionString(std::string_view name) {
+    // split the same way as split(), keeping empty names
+    auto count = static_cast<std::size_t>(std::count(name.begin(), name.end(), '|')) + 1;
+    // the views, then the names with their dashes
+    std::shared_ptr<char[]> block(new char[count * sizeof(std::string_view) + name.size() + 1]);
+    auto views = reinterpret_cast<std::string_view*>(block.get());
+    auto text = block.get() + count * sizeof(std::string_view);
+
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto end = std::min(name.find('|', begin), name.size());
+        auto part = name.substr(begin, end - begin);
+        auto start = text;
+        unless (part == "<>") {
+            *text++ = '-';
+        }
+        std::memcpy(text, part.data(), part.size());
+        text += part.size();
+        new(views + i) std::string_view(start, static_cast<std::size_t>(text - start));
+        begin = end + 1;
     }
-}
 
-const std::vector<std::string>& info::parse::detail::OptionString::getNames() const {
-    return _names;
+    _block = std::move(block);
+    _names = NameView(views, count);
 }
 
-std::vector<std::string> info::parse::detail::OptionString::prependDashes(std::vector<std::string>&& rawNames) {
-    std::vector<std::string> retVal(rawNames.size());
-    std::transform(rawNames.begin(), rawNames.end(), retVal.begin(), [](const std::string& str) {
-      if (str == "<>")
-          return str;
-      return "-" + str;
-    });
-    return retVal;
+info::parse::detail::OptionString::OptionString(const std::string& str)
+        : OptionString(std::string_view(str)) {}
+
+const info::parse::detail::NameView& info::parse::detail::OptionString::getNames() const {
+    return _names;
 }
 
 std::vector<info::parse::detail::searchableOf<char>>
 info::parse::detail::OptionString::get() const {
     typedef std::vector<info::parse::detail::searchableOf<char>> Vec;
     Vec retVal;
-    for (Vec::size_type i = 0; i < _names.size(); ++i) {
-        retVal.emplace_back(std::make_tuple(_names[i], _kmpSearch[i], _bmSearch[i]));
+    for (auto&& name : _names) {
+        retVal.emplace_back(std::string(name),
+                            Lazy<FinderEins<char>, std::string&>([](/*const */std::string& name) {
+                              return std::make_shared<FinderEins<char>>(name.begin(), name.end());
+                            }),
+                            Lazy<FinderZwei<char>, std::string&>([](/*const */std::string& name) {
+                              return std::make_shared<FinderZwei<char>>(name.begin(), name.end());
+                            }));
     }
     return retVal;
 }
 
 info::parse::detail::OptionString::OptionString(const char* name)
-        : OptionString(std::string(name)) {}
+        : OptionString(std::string_view(name)) {}
 
-const std::string& info::parse::detail::OptionString::operator[](std::vector<std::string>::size_type i) const {
+std::string_view info::parse::detail::OptionString::operator[](NameView::size_type i) const {
     return _names.at(i);
 }
 
@@ -55,7 +72,7 @@ info::parse::detail::OptionString::operator*() const {
 }
 
 bool info::parse::detail::OptionString::operator==(const info::parse::detail::OptionString& rhs) const {
-    return _names == rhs._names;
+    return std::equal(_names.begin(), _names.end(), rhs._names.begin(), rhs._names.end());
 }
 
 bool info::parse::detail::OptionString::operator!=(const info::parse::detail::OptionString& rhs) const {
@@ -11,8 +11,3 @@
 
 #include "include.hpp"
 #include INFO_PARSE_INCLUDE(Option_.hpp)
-
-info::parse::detail::bad_function_callback::bad_function_callback(int a)
-        : logic_error("Too many parameters required for function callback maximum is 2. [with sizeof...(Args) = "
-                      + std::to_string(a) +
-                      "] ") {}
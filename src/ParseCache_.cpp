@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <cstring>
+#include <functional>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(ParseCache_.hpp)
+#include INFO_PARSE_INCLUDE(ParseSession_.hpp)
+
+namespace {
+  constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /// Mixes eight bytes at a time; the last few of each argument are read
+  /// in at most two loads, as arguments are mostly short
+  std::uint64_t hashArgs(const std::vector<std::string_view>& args) {
+      constexpr std::uint64_t k = 0x9e3779b97f4a7c15u;
+      std::uint64_t hash = args.size() * k;
+      auto mix = [&](std::uint64_t word) {
+        hash = (hash ^ word) * k;
+        hash ^= hash >> 29;
+      };
+      for (auto arg : args) {
+          auto data = arg.data();
+          auto size = arg.size();
+          std::uint64_t word;
+          for (; size >= 8; data += 8, size -= 8) {
+              std::memcpy(&word, data, 8);
+              mix(word);
+          }
+          if (size >= 4) {
+              std::uint32_t low, high;
+              std::memcpy(&low, data, 4);
+              std::memcpy(&high, data + size - 4, 4);
+              word = low | std::uint64_t(high) << 32;
+          } else if (size > 0) {
+              word = std::uint64_t(std::uint8_t(data[0])) << 16
+                     | std::uint64_t(std::uint8_t(data[size / 2])) << 8
+                     | std::uint8_t(data[size - 1]);
+          } else {
+              word = 0;
+          }
+          mix(word ^ std::uint64_t(arg.size()) << 56);
+      }
+      return hash;
+  }
+
+  /// Whether the arguments are the ones stored, as their ends in the text;
+  /// the lengths are compared first, as that is cheaper than the bytes
+  bool sameArgs(const std::string& text, const std::vector<std::size_t>& ends,
+                const std::vector<std::string_view>& args) {
+      if (ends.size() != args.size())
+          return false;
+      std::size_t begin = 0;
+      for (std::size_t i = 0; i < args.size(); ++i) {
+          if (ends[i] - begin != args[i].size())
+              return false;
+          begin = ends[i];
+      }
+      begin = 0;
+      for (std::size_t i = 0; i < args.size(); ++i) {
+          if (std::memcmp(text.data() + begin, args[i].data(), args[i].size()) != 0)
+              return false;
+          begin = ends[i];
+      }
+      return true;
+  }
+
+  /**
+   * Reports to the sink of the parse, and records where
+   * each value and remaining argument was found.
+   */
+  template<class Entry>
+  class RecordingSink {
+      /// Interface
+  public:
+      void match(std::size_t option, std::string_view value) {
+          _sink.match(option, value);
+          if (_current != npos && contains(_args[_current], value)) {
+              auto offset = static_cast<std::size_t>(value.data() - _args[_current].data());
+              _entry.events.push_back({option, _current, offset, value.size(), {}});
+          } else {
+              _entry.events.push_back({option, npos, 0, 0, value});
+          }
+      }
+
+      void rest(std::string_view arg) {
+          _sink.rest(arg);
+          _entry.rest.push_back(_current);
+      }
+
+      /// Sets the argument fed next; npos when finishing
+      void at(std::size_t arg) {
+          _current = arg;
+      }
+
+      /// Lifecycle
+  public:
+      RecordingSink(info::parse::detail::EventSink_& sink,
+                    const std::vector<std::string_view>& args,
+                    Entry& entry)
+              : _sink(sink),
+                _args(args),
+                _entry(entry) {}
+
+      /// Fields
+  private:
+      info::parse::detail::EventSink_& _sink;
+      const std::vector<std::string_view>& _args;
+      Entry& _entry;
+      std::size_t _current = npos;
+
+      /// Methods
+  private:
+      static bool contains(std::string_view arg, std::string_view value) {
+          std::less_equal<const char*> le;
+          return le(arg.data(), value.data())
+                 && le(value.data() + value.size(), arg.data() + arg.size());
+      }
+  };
+}
+
+void info::parse::detail::ParseCache_::resize(std::size_t capacity) {
+    _capacity = capacity;
+    while (_entries.size() > _capacity) {
+        _byHash.erase(_entries.back().hash);
+        _entries.pop_back();
+    }
+}
+
+bool info::parse::detail::ParseCache_::replayArgs(std::size_t version,
+                                                  std::vector<ParseEvent_>& events,
+                                                  std::vector<std::string_view>& rest) {
+    if (version != _version) {
+        _entries.clear();
+        _byHash.clear();
+        _version = version;
+    }
+
+    _hash = hashArgs(_args);
+    auto found = _byHash.find(_hash);
+    if (found == _byHash.end() || !sameArgs(found->second->text, found->second->ends, _args)) {
+        ++_stats.misses;
+        return false;
+    }
+
+    auto entry = found->second;
+    _entries.splice(_entries.begin(), _entries, entry);
+    for (auto&& event : entry->events) {
+        events.push_back({event.option, event.arg == npos
+                                        ? event.literal
+                                        : _args[event.arg].substr(event.offset, event.length)});
+    }
+    for (auto arg : entry->rest) {
+        rest.push_back(_args[arg]);
+    }
+    ++_stats.hits;
+    return true;
+}
+
+void info::parse::detail::ParseCache_::parse(const OptionIndex_& index, EventSink_& sink,
+                                             std::vector<std::uint64_t>& used) {
+    auto& entry = allocate();
+    try {
+        entry.text.clear();
+        entry.ends.clear();
+        entry.events.clear();
+        entry.rest.clear();
+        for (auto arg : _args) {
+            entry.text += arg;
+            entry.ends.push_back(entry.text.size());
+        }
+
+        RecordingSink<Entry> recorder(sink, _args, entry);
+        ParseSession_<RecordingSink<Entry>> session(index, recorder, used);
+        for (std::size_t i = 0; i < _args.size(); ++i) {
+            recorder.at(i);
+            session.feed(_args[i]);
+        }
+        recorder.at(npos);
+        session.finish();
+
+        entry.hash = _hash;
+        _byHash[_hash] = _entries.begin();
+    } catch (...) {
+        // allocate() unmapped it
+        _entries.pop_front();
+        throw;
+    }
+}
+
+info::parse::detail::ParseCache_::Entry& info::parse::detail::ParseCache_::allocate() {
+    auto reused = _byHash.find(_hash);
+    if (reused != _byHash.end()) {
+        // same hash, different arguments
+        _entries.splice(_entries.begin(), _entries, reused->second);
+        _byHash.erase(reused);
+    } else if (_entries.size() >= _capacity) {
+        _byHash.erase(_entries.back().hash);
+        _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+    } else {
+        _entries.emplace_front();
+    }
+    return _entries.front();
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(ParseResult.hpp)
+
+std::size_t info::parse::ParseResult::size() const {
+    return _matches.size();
+}
+
+std::size_t info::parse::ParseResult::option(std::size_t i) const {
+    return _matches[i].option;
+}
+
+std::string_view info::parse::ParseResult::value(std::size_t i) const {
+    return std::string_view(_values).substr(_matches[i].offset, _matches[i].length);
+}
+
+std::optional<std::string_view> info::parse::ParseResult::find(std::size_t option) const {
+    for (std::size_t i = 0; i < _matches.size(); ++i) {
+        if (_matches[i].option == option)
+            return value(i);
+    }
+    return std::nullopt;
+}
+
+const std::string& info::parse::ParseResult::rest() const {
+    return _rest;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(ParseStream.hpp)
+#include INFO_PARSE_INCLUDE(ParseSession_.hpp)
+
+namespace {
+  /**
+   * Hands values to their options right away, and copies the
+   * remaining arguments, as the fed ones are gone after the call.
+   */
+  class StreamSink {
+      /// Interface
+  public:
+      void match(std::size_t option, std::string_view value) {
+          _index[option].accept(value);
+      }
+
+      void rest(std::string_view arg) {
+          _rest.emplace_back(arg);
+      }
+
+      /// Lifecycle
+  public:
+      StreamSink(const info::parse::detail::OptionIndex_& index, std::vector<std::string>& rest)
+              : _index(index),
+                _rest(rest) {}
+
+      /// Fields
+  private:
+      const info::parse::detail::OptionIndex_& _index;
+      std::vector<std::string>& _rest;
+  };
+}
+
+struct info::parse::ParseStream::State {
+    explicit State(const detail::OptionIndex_& index)
+            : sink(index, rest),
+              session(index, sink, used) {}
+
+    std::vector<std::string> rest;
+    StreamSink sink;
+    std::vector<std::uint64_t> used;
+    detail::ParseSession_<StreamSink> session;
+};
+
+info::parse::ParseStream::ParseStream(const detail::OptionIndex_& index)
+        : _state(std::make_unique<State>(index)) {}
+
+info::parse::ParseStream::ParseStream(ParseStream&& other) noexcept = default;
+
+info::parse::ParseStream&
+info::parse::ParseStream::operator=(ParseStream&& other) noexcept = default;
+
+info::parse::ParseStream::~ParseStream() = default;
+
+info::parse::ParseStream& info::parse::ParseStream::feed(std::string_view arg) {
+    _state->session.feed(arg);
+    return *this;
+}
+
+void info::parse::ParseStream::finish() {
+    _state->session.finish();
+}
+
+void info::parse::ParseStream::reset() {
+    _state->session.reset();
+    _state->rest.clear();
+}
+
+bool info::parse::ParseStream::pending() const {
+    return _state->session.pending();
+}
+
+const std::vector<std::string>& info::parse::ParseStream::rest() const {
+    return _state->rest;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+#include "include.hpp"
+#include INFO_PARSE_INCLUDE(WorkPool_.hpp)
+
+namespace {
+  /// A worker's range of items; on its own cache line, so
+  /// the cursors of different workers do not false share
+  struct alignas(64) Range {
+      std::atomic<std::size_t> next;
+      std::size_t end;
+  };
+}
+
+/// The items of one batch, split among its workers
+struct info::parse::detail::WorkPool_::Batch {
+    Batch(std::size_t items, std::size_t workers, std::size_t grain, const Work& work)
+            : workers(workers),
+              grain(grain),
+              work(work),
+              ranges(new Range[workers]) {
+        for (std::size_t i = 0; i < workers; ++i) {
+            ranges[i].next.store(items * i / workers, std::memory_order_relaxed);
+            ranges[i].end = items * (i + 1) / workers;
+        }
+    }
+
+    /// Does grains as the worker until none are left
+    void doAs(std::size_t self) {
+        try {
+            // own range first, then every other one in turn
+            for (std::size_t k = 0; k < workers; ++k) {
+                auto& range = ranges[(self + k) % workers];
+                while (!failed.load(std::memory_order_relaxed)) {
+                    auto begin = range.next.fetch_add(grain, std::memory_order_relaxed);
+                    if (begin >= range.end)
+                        break;
+                    work(self, begin, std::min(begin + grain, range.end));
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorLock);
+            unless (error) {
+                error = std::current_exception();
+            }
+            failed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t workers;
+    std::size_t grain;
+    const Work& work;
+    std::unique_ptr<Range[]> ranges;
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorLock;
+};
+
+info::parse::detail::WorkPool_::WorkPool_(std::size_t threads, std::size_t grain)
+        : _threads(threads),
+          _grain(std::max<std::size_t>(grain, 1)) {
+    if (_threads == 0)
+        _threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _helpers.reserve(_threads - 1);
+    try {
+        for (std::size_t i = 1; i < _threads; ++i) {
+            _helpers.emplace_back(&WorkPool_::help, this, i);
+        }
+    } catch (...) {
+        // the destructor is not called for a pool not constructed
+        stop();
+        throw;
+    }
+}
+
+info::parse::detail::WorkPool_::~WorkPool_() {
+    stop();
+}
+
+void info::parse::detail::WorkPool_::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopping = true;
+    }
+    _started.notify_all();
+    for (auto& helper : _helpers) {
+        helper.join();
+    }
+}
+
+info::parse::detail::WorkPool_& info::parse::detail::WorkPool_::shared() {
+    static WorkPool_ pool;
+    return pool;
+}
+
+std::size_t info::parse::detail::WorkPool_::workersFor(std::size_t items,
+                                                      std::size_t threads) const {
+    auto grains = (items + _grain - 1) / _grain;
+    auto most = threads == 0 ? _threads : std::min(threads, _threads);
+    return std::max<std::size_t>(std::min(most, grains), 1);
+}
+
+void info::parse::detail::WorkPool_::run(std::size_t items, const Work& work,
+                                         std::size_t threads) {
+    if (items == 0)
+        return;
+
+    auto workers = workersFor(items, threads);
+    if (workers == 1) {
+        work(0, 0, items);
+        return;
+    }
+
+    std::lock_guard<std::mutex> running(_running);
+    Batch batch(items, workers, _grain, work);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _batch = &batch;
+        _busy = workers - 1;
+        ++_generation;
+    }
+    _started.notify_all();
+
+    batch.doAs(0);
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _finished.wait(lock, [this] { return _busy == 0; });
+        _batch = nullptr;
+    }
+
+    if (batch.error)
+        std::rethrow_exception(batch.error);
+}
+
+void info::parse::detail::WorkPool_::help(std::size_t self) {
+    std::size_t seen = 0;
+    std::unique_lock<std::mutex> lock(_lock);
+    for (;;) {
+        _started.wait(lock, [&] { return _stopping || _generation != seen; });
+        if (_stopping)
+            return;
+        seen = _generation;
+        // the batch may need fewer workers than the pool has, and
+        // be over already if so
+        if (!_batch || self >= _batch->workers)
+            continue;
+
+        auto& batch = *_batch;
+        lock.unlock();
+        batch.doAs(self);
+        lock.lock();
+        unless (--_busy) {
+            _finished.notify_one();
+        }
+    }
+}
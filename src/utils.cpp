@@ -9,7 +9,12 @@
 // Created by bodand on 2019-01-23.
 //
 
+#include <string>
+#include <locale>
+#include <cstdint>
+#include <charconv>
 #include <iostream>
+#include <algorithm>
 
 #include "include.hpp"
 #include INFO_PARSE_INCLUDE(utils.hpp)
@@ -21,16 +26,475 @@
 
 #endif
 
+//&!off
+#if !defined(INFO_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+  #define INFO_SIMD_SSE2
+  #include <emmintrin.h>
+  #if defined(__AVX2__)
+    #define INFO_SIMD_AVX2
+    #include <immintrin.h>
+  #elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // Not enabled for the whole build, but can be
+    // compiled for, and chosen at runtime
+    #define INFO_SIMD_AVX2
+    #define INFO_SIMD_AVX2_DISPATCH
+    #define INFO_SIMD_AVX2_TARGET __attribute__((target("avx2")))
+    #include <immintrin.h>
+  #endif
+#endif
+#ifndef INFO_SIMD_AVX2_TARGET
+  #define INFO_SIMD_AVX2_TARGET
+#endif
+//&!on
+
+namespace {
+  // The whitespace kernels read the input from in, and write to out, which
+  // has 32 bytes of room after the end of the output; inRun is whether the
+  // last byte was whitespace. They return the end of the written output.
+  // Bytes of 0x80 and above are whitespace if the ctype says so, as they
+  // were for std::regex; blocks containing any are left to collapseScalar.
+
+  bool isWhitespace(char c, const std::ctype<char>& ctype) {
+      if (static_cast<unsigned char>(c) >= 0x80)
+          return ctype.is(std::ctype_base::space, c);
+      return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+  char* collapseScalar(const char* in, const char* end, char* out, bool& inRun,
+                       const std::ctype<char>& ctype) {
+      for (; in != end; ++in) {
+          if (isWhitespace(*in, ctype)) {
+              unless (inRun) {
+                  *out++ = ' ';
+              }
+              inRun = true;
+          } else {
+              *out++ = *in;
+              inRun = false;
+          }
+      }
+      return out;
+  }
+
+#ifdef INFO_SIMD_SSE2
+
+  int countTrailingZeros(std::uint32_t x) {
+  #if defined(__GNUC__)
+      return __builtin_ctz(x);
+  #else
+      int n = 0;
+      for (; (x & 1u) == 0; x >>= 1u) {
+          ++n;
+      }
+      return n;
+  #endif
+  }
+
+  // Writes the bytes of the block whose bit is not set in drop.
+  // Drops are rare, so the kept stretches between them are
+  // copied whole, each with one store of the full block size from
+  // where the stretch begins; block is padded to twice its size and
+  // out has that much room after the end of the output.
+  template<std::size_t Size, class Copy>
+  char* compact(const char* block, std::uint32_t drop, char* out, Copy copy) {
+      std::size_t pos = 0;
+      for (; drop != 0; drop &= drop - 1) {
+          auto i = static_cast<std::size_t>(countTrailingZeros(drop));
+          copy(out, block + pos);
+          out += i - pos;
+          pos = i + 1;
+      }
+      copy(out, block + pos);
+      return out + (Size - pos);
+  }
+
+  char* collapseSse2(const char* in, const char* end, char* out, bool& inRun,
+                     const std::ctype<char>& ctype) {
+      const __m128i nine = _mm_set1_epi8(9);
+      const __m128i four = _mm_set1_epi8(4);
+      const __m128i space = _mm_set1_epi8(' ');
+      for (; end - in >= 16; in += 16) {
+          __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+          if (_mm_movemask_epi8(x) != 0) {
+              out = collapseScalar(in, in + 16, out, inRun, ctype);
+              continue;
+          }
+          // \t..\r is 9..13, so x - 9 is at most 4 unsigned
+          __m128i shifted = _mm_sub_epi8(x, nine);
+          __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, four), shifted);
+          __m128i ws = _mm_or_si128(control, _mm_cmpeq_epi8(x, space));
+          auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(ws));
+          if (mask == 0) {
+              _mm_storeu_si128(reinterpret_cast<__m128i*>(out), x);
+              out += 16;
+              inRun = false;
+              continue;
+          }
+
+          __m128i spaced = _mm_or_si128(_mm_andnot_si128(ws, x), _mm_and_si128(ws, space));
+          // Whitespace following whitespace is dropped
+          std::uint32_t drop = mask & ((mask << 1u) | static_cast<std::uint32_t>(inRun));
+          inRun = (mask >> 15u) & 1u;
+          if (drop == 0) {
+              _mm_storeu_si128(reinterpret_cast<__m128i*>(out), spaced);
+              out += 16;
+              continue;
+          }
+          alignas(16) char block[32]{};
+          _mm_store_si128(reinterpret_cast<__m128i*>(block), spaced);
+          out = compact<16>(block, drop, out, [](char* to, const char* from) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(to),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+          });
+      }
+      return collapseScalar(in, end, out, inRun, ctype);
+  }
+
+#endif
+#ifdef INFO_SIMD_AVX2
+
+  INFO_SIMD_AVX2_TARGET
+  char* collapseAvx2(const char* in, const char* end, char* out, bool& inRun,
+                     const std::ctype<char>& ctype) {
+      const __m256i nine = _mm256_set1_epi8(9);
+      const __m256i four = _mm256_set1_epi8(4);
+      const __m256i space = _mm256_set1_epi8(' ');
+      for (; end - in >= 32; in += 32) {
+          __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+          if (_mm256_movemask_epi8(x) != 0) {
+              out = collapseScalar(in, in + 32, out, inRun, ctype);
+              continue;
+          }
+          __m256i shifted = _mm256_sub_epi8(x, nine);
+          __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, four), shifted);
+          __m256i ws = _mm256_or_si256(control, _mm256_cmpeq_epi8(x, space));
+          auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(ws));
+          if (mask == 0) {
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), x);
+              out += 32;
+              inRun = false;
+              continue;
+          }
+
+          __m256i spaced = _mm256_or_si256(_mm256_andnot_si256(ws, x), _mm256_and_si256(ws, space));
+          std::uint32_t drop = mask & ((mask << 1u) | static_cast<std::uint32_t>(inRun));
+          inRun = (mask >> 31u) & 1u;
+          if (drop == 0) {
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), spaced);
+              out += 32;
+              continue;
+          }
+          alignas(32) char block[64]{};
+          _mm256_store_si256(reinterpret_cast<__m256i*>(block), spaced);
+          out = compact<32>(block, drop, out, [](char* to, const char* from) INFO_SIMD_AVX2_TARGET {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(to),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from)));
+          });
+      }
+      return collapseScalar(in, end, out, inRun, ctype);
+  }
+
+#endif
+
+  // " -" pairs, the possible beginnings of flag bundles, are searched for
+  // by comparing each block with ' ' and the block one byte later with '-'.
+  // The finders return the position of the space, or end.
+
+  const char* findSpaceDashScalar(const char* in, const char* end) {
+      for (; end - in >= 2; ++in) {
+          if (in[0] == ' ' && in[1] == '-')
+              return in;
+      }
+      return end;
+  }
+
+#ifdef INFO_SIMD_SSE2
+
+  const char* findSpaceDashSse2(const char* in, const char* end) {
+      const __m128i space = _mm_set1_epi8(' ');
+      const __m128i dash = _mm_set1_epi8('-');
+      for (; end - in >= 17; in += 16) {
+          __m128i here = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+          __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 1));
+          auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(
+                  _mm_and_si128(_mm_cmpeq_epi8(here, space), _mm_cmpeq_epi8(next, dash))));
+          if (mask != 0)
+              return in + countTrailingZeros(mask);
+      }
+      return findSpaceDashScalar(in, end);
+  }
+
+#endif
+#ifdef INFO_SIMD_AVX2
+
+  INFO_SIMD_AVX2_TARGET
+  const char* findSpaceDashAvx2(const char* in, const char* end) {
+      const __m256i space = _mm256_set1_epi8(' ');
+      const __m256i dash = _mm256_set1_epi8('-');
+      for (; end - in >= 33; in += 32) {
+          __m256i here = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+          __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 1));
+          auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                  _mm256_and_si256(_mm256_cmpeq_epi8(here, space), _mm256_cmpeq_epi8(next, dash))));
+          if (mask != 0)
+              return in + countTrailingZeros(mask);
+      }
+      return findSpaceDashScalar(in, end);
+  }
+
+#endif
+
+  bool useAvx2() {
+#if defined(INFO_SIMD_AVX2_DISPATCH)
+      return __builtin_cpu_supports("avx2");
+#elif defined(INFO_SIMD_AVX2)
+      return true;
+#else
+      return false;
+#endif
+  }
+
+  using Kernel = char* (*)(const char*, const char*, char*, bool&, const std::ctype<char>&);
+
+  Kernel chooseKernel() {
+#if defined(INFO_SIMD_AVX2)
+      if (useAvx2())
+          return collapseAvx2;
+#endif
+#if defined(INFO_SIMD_SSE2)
+      return collapseSse2;
+#else
+      return collapseScalar;
+#endif
+  }
+
+  using Finder = const char* (*)(const char*, const char*);
+
+  Finder chooseFinder() {
+#if defined(INFO_SIMD_AVX2)
+      if (useAvx2())
+          return findSpaceDashAvx2;
+#endif
+#if defined(INFO_SIMD_SSE2)
+      return findSpaceDashSse2;
+#else
+      return findSpaceDashScalar;
+#endif
+  }
+
+  /**
+   * Appends the argument escaped as itrStr escapes it: `$` becomes
+   * `\$`, and each run of whitespace, as std::regex's `\s` sees it,
+   * becomes `$n$`, n being the length of the run.
+   */
+  template<class CharT>
+  void appendEscaped(const CharT* pos, const CharT* end,
+                     const std::ctype<CharT>& ctype, std::basic_string<CharT>& out) {
+      auto isSpace = [&](CharT c) { return ctype.is(std::ctype_base::space, c); };
+      while (pos != end) {
+          auto plain = std::find_if(pos, end, [&](CharT c) { return c == CharT('$') || isSpace(c); });
+          out.append(pos, plain);
+          if (plain == end)
+              break;
+          if (*plain == CharT('$')) {
+              out += CharT('\\');
+              out += CharT('$');
+              pos = plain + 1;
+              continue;
+          }
+          auto run = std::find_if_not(plain, end, isSpace);
+          char digits[20];
+          auto digitsEnd = std::to_chars(digits, digits + sizeof digits,
+                                         static_cast<std::size_t>(run - plain)).ptr;
+          out += CharT('$');
+          for (auto d = digits; d != digitsEnd; ++d) {
+              out += static_cast<CharT>(*d);
+          }
+          out += CharT('$');
+          pos = run;
+      }
+  }
+
+  template<class CharT>
+  void escape(std::basic_string<CharT>& str) {
+      std::locale locale;
+      auto& ctype = std::use_facet<std::ctype<CharT>>(locale);
+      auto first = std::find_if(str.begin(), str.end(), [&](CharT c) {
+        return c == CharT('$') || ctype.is(std::ctype_base::space, c);
+      });
+      if (first == str.end())
+          return;
+      std::basic_string<CharT> out;
+      out.reserve(str.size() + str.size() / 4 + 4);
+      out.append(str.begin(), first);
+      appendEscaped(str.data() + (first - str.begin()), str.data() + str.size(), ctype, out);
+      str.swap(out);
+  }
+
+  /**
+   * Undoes escape in one pass, quirks included: a `$n$` is only
+   * replaced if preceded by a character other than `\`, which is
+   * consumed with it, as the regex `([^\\])\$(\d+)\$` matches it;
+   * then each `\$` of the result becomes `$`.
+   */
+  template<class CharT>
+  void unescape(std::basic_string<CharT>& str) {
+      if (str.find(CharT('$')) == std::basic_string<CharT>::npos)
+          return;
+      std::locale locale;
+      auto& ctype = std::use_facet<std::ctype<CharT>>(locale);
+      std::basic_string<CharT> out;
+      out.reserve(str.size());
+      auto put = [&](CharT c) {
+        if (c == CharT('$') && !out.empty() && out.back() == CharT('\\')) {
+            out.back() = c;
+        } else {
+            out += c;
+        }
+      };
+
+      const auto size = str.size();
+      for (std::size_t pos = 0; pos < size;) {
+          CharT c = str[pos];
+          if (c != CharT('\\') && pos + 1 < size && str[pos + 1] == CharT('$')) {
+              auto digits = pos + 2;
+              auto last = digits;
+              bool ascii = true;
+              while (last < size && ctype.is(std::ctype_base::digit, str[last])) {
+                  ascii = ascii && str[last] >= CharT('0') && str[last] <= CharT('9');
+                  ++last;
+              }
+              if (last != digits && last < size && str[last] == CharT('$')) {
+                  int count = 0;
+                  if (ascii && last - digits < 10) {
+                      for (auto d = digits; d != last; ++d) {
+                          count = count * 10 + static_cast<int>(str[d] - CharT('0'));
+                      }
+                  } else {
+                      // overflow and odd digits throw, as they always did
+                      count = std::stoi(str.substr(digits, last - digits));
+                  }
+                  put(c);
+                  out.append(static_cast<std::size_t>(count), CharT(' '));
+                  pos = last + 1;
+                  continue;
+              }
+          }
+          put(c);
+          ++pos;
+      }
+      str.swap(out);
+  }
+}
+
 namespace info::parse {
   std::string makeMonolithArgs(int argc, char** argv) {
-      std::ostringstream retStream;
-      retStream << " ";
-      for (int i = 0; i < argc; ++i) {
-          std::string s(argv[i]);
-          itrStr(s);
-          retStream << s << " ";
+      std::vector<std::string_view> args(argv, argv + argc);
+      return makeMonolithArgs(args);
+  }
+
+  std::string makeMonolithArgs(const std::vector<std::string_view>& args) {
+      std::locale locale;
+      auto& ctype = std::use_facet<std::ctype<char>>(locale);
+      std::size_t size = 1;
+      for (auto&& arg : args) {
+          size += arg.size() + 1;
+      }
+      std::string joined;
+      joined.reserve(size + size / 4);
+      joined += ' ';
+      for (auto&& arg : args) {
+          appendEscaped(arg.data(), arg.data() + arg.size(), ctype, joined);
+          joined += ' ';
+      }
+      return joined;
+  }
+
+  void appendMonolithArg(std::string_view arg, std::string& out) {
+      // only `$`, ASCII whitespace, and bytes above ASCII may be escaped
+      auto plain = std::none_of(arg.begin(), arg.end(), [](char c) {
+        auto byte = static_cast<unsigned char>(c);
+        return c == '$' || byte <= ' ' || byte >= 0x80;
+      });
+      if (plain) {
+          out += arg;
+      } else {
+          std::locale locale;
+          appendEscaped(arg.data(), arg.data() + arg.size(),
+                        std::use_facet<std::ctype<char>>(locale), out);
+      }
+      out += ' ';
+  }
+
+  std::string joinArgs(const std::vector<std::string_view>& args) {
+      std::size_t size = 1;
+      for (auto&& arg : args) {
+          size += arg.size() + 1;
+      }
+      std::string joined;
+      joined.reserve(size);
+      joined += ' ';
+      for (auto&& arg : args) {
+          joined += arg;
+          joined += ' ';
+      }
+      return joined;
+  }
+
+  void collapseWhitespace(std::string_view in, std::string& out) {
+      static const Kernel kernel = chooseKernel();
+      std::locale locale;
+      auto& ctype = std::use_facet<std::ctype<char>>(locale);
+      out.resize(in.size() + 32);
+      bool inRun = false;
+      auto begin = out.data();
+      auto end = kernel(in.data(), in.data() + in.size(), begin, inRun, ctype);
+      out.resize(static_cast<std::size_t>(end - begin));
+  }
+
+  void explodeBundles(std::string_view in, std::string& out,
+                      const std::function<bool(std::string_view)>& isName) {
+      static const Finder find = chooseFinder();
+      out.clear();
+      out.reserve(in.size() + in.size() / 2);
+      auto pos = in.data();
+      auto end = pos + in.size();
+      for (;;) {
+          auto bundle = find(pos, end);
+          out.append(pos, bundle);
+          if (bundle == end || bundle + 2 == end)
+              break; // a dangling " -" at the end is dropped
+          pos = bundle + 2;
+          if (*pos == '-' || *pos == ' ') {
+              out.append(bundle, pos);
+              continue;
+          }
+
+          auto bundleEnd = std::find(pos, end, ' ');
+          if (isName && isName(std::string_view(bundle + 1, static_cast<std::size_t>(bundleEnd - bundle - 1)))) {
+              out.append(bundle, bundleEnd);
+              pos = bundleEnd;
+              continue;
+          }
+          // Each flag takes at most five bytes; room is made once for the bundle
+          auto size = out.size();
+          out.resize(size + 5 * static_cast<std::size_t>(bundleEnd - pos));
+          auto write = out.data() + size;
+          std::size_t spaces = 1;
+          for (; pos != bundleEnd; ++pos) {
+              if (*pos == '-')
+                  continue;
+              write[0] = ' ';
+              write[1] = '-';
+              write[2] = *pos;
+              write[3] = ' ';
+              write[4] = ' ';
+              // Every flag but the first is followed by two spaces
+              write += 3 + spaces;
+              spaces = 2;
+          }
+          out.resize(static_cast<std::size_t>(write - out.data()));
       }
-      return retStream.str();
   }
 
   void replaceAll(std::string& str, const std::string& from, const std::string& to) {
@@ -53,93 +517,20 @@ namespace info::parse {
       }
   }
 
-  template<class Traits, class CharT, class UnaryFunction>
-  std::basic_string<CharT> regex_replace(const std::basic_string<CharT>& s,
-                                         const std::basic_regex<CharT, Traits>& re, UnaryFunction f) {
-      return regex_replace(s.cbegin(), s.cend(), re, f);
-  }
-
-  template<class BidirIt, class Traits, class CharT, class UnaryFunction>
-  std::basic_string<CharT> regex_replace(BidirIt first, BidirIt last,
-                                         const std::basic_regex<CharT, Traits>& re, UnaryFunction f) {
-      std::basic_string<CharT> s;
-
-      typename std::match_results<BidirIt>::difference_type
-              positionOfLastMatch = 0;
-      auto endOfLastMatch = first;
-
-      auto callback = [&](const std::match_results<BidirIt>& match) {
-        auto positionOfThisMatch = match.position(0);
-        auto diff = positionOfThisMatch - positionOfLastMatch;
-
-        auto startOfThisMatch = endOfLastMatch;
-        std::advance(startOfThisMatch, diff);
-
-        s.append(endOfLastMatch, startOfThisMatch);
-        s.append(f(match));
-
-        auto lengthOfMatch = match.length(0);
-
-        positionOfLastMatch = positionOfThisMatch + lengthOfMatch;
-
-        endOfLastMatch = startOfThisMatch;
-        std::advance(endOfLastMatch, lengthOfMatch);
-      };
-
-      std::regex_iterator<BidirIt> begin(first, last, re), end;
-      std::for_each(begin, end, callback);
-
-      s.append(endOfLastMatch, last);
-
-      return s;
-  }
-
   void itrStr(std::string& str) {
-      replaceAll(str, "$", R"(\$)");
-      str = regex_replace(str, std::regex(R"(\s+)"),
-                          [](const std::smatch& m) {
-                            std::stringstream stream;
-                            stream << "$" << m.length() << "$";
-                            return stream.str();
-                          });
+      escape(str);
   }
 
   void arcItrStr(std::string& str) {
-      str = regex_replace(str, std::regex(R"(([^\\])\$(\d+)\$)"),
-                          [](const std::smatch& m) {
-                            auto i = std::stoi(m.str(2));
-                            std::stringstream stream;
-                            stream << m.str(1);
-                            for (int j = 0; j < i; ++j) {
-                                stream << ' ';
-                            }
-                            return stream.str();
-                          });
-      replaceAll(str, R"(\$)", "$");
+      unescape(str);
   }
 
   void itrStr(std::wstring& str) {
-      replaceAll(str, L"$", LR"(\$)");
-      str = regex_replace(str, std::wregex(LR"(\s+)"),
-                          [](const std::wsmatch& m) {
-                            std::wstringstream stream;
-                            stream << L"$" << m.length() << L"$";
-                            return stream.str();
-                          });
+      escape(str);
   }
 
   void arcItrStr(std::wstring& str) {
-      str = regex_replace(str, std::wregex(LR"(([^\\])\$(\d+)\$)"),
-                          [](const std::wsmatch& m) {
-                            auto i = std::stoi(m.str(2));
-                            std::wstringstream stream;
-                            stream << m.str(1);
-                            for (int j = 0; j < i; ++j) {
-                                stream << L' ';
-                            }
-                            return stream.str();
-                          });
-      replaceAll(str, LR"(\$)", L"$");
+      unescape(str);
   }
 
   std::vector<std::string> split(const std::string& toSplit, char c) {
@@ -181,4 +572,29 @@ namespace info::parse {
 #endif
   }
 
+  bool isTruthy(std::string_view val) {
+      auto is = [&](std::string_view literal) {
+        return val.size() == literal.size()
+               && std::equal(val.begin(), val.end(), literal.begin(), [](char a, char b) {
+                 return std::tolower((unsigned char) a) == b;
+               });
+      };
+
+      if (is("yes") || is("true")) { // true values
+          return true;
+      } else if (is("no") || is("false")) { // false values
+          return false;
+      } else if (!val.empty() && std::isdigit((unsigned char) val[0])) {
+          // starts with digit means we check numeric truthyness
+          auto digits = std::find_if_not(val.begin(), val.end(), [](unsigned char c) {
+            return std::isdigit(c);
+          });
+          return std::any_of(val.begin(), digits, [](char c) { return c != '0'; });
+      }
+      // if value is only space it is falsy, otherwise truthy
+      return !std::all_of(val.begin(), val.end(), [](unsigned char c) {
+        return std::isspace(c);
+      });
+  }
+
 }
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <new>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <string_view>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+#include "../include/info/parse/StaticOptionsParser.hpp"
+
+namespace test_allocations {
+  /// Allocations made through operator new by any thread
+  inline std::atomic<std::size_t> allocations{0};
+
+  /**
+   * Counts the allocations made while calling f
+   */
+  template<class F>
+  std::size_t countAllocations(F&& f) {
+      auto before = allocations.load();
+      f();
+      return allocations.load() - before;
+  }
+}
+
+// Replaces the global allocation functions of the test executable,
+// including the ones called by the library
+void* operator new(std::size_t size) {
+    ++test_allocations::allocations;
+    if (auto ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+BOOST_AUTO_TEST_SUITE(Test_Allocations)
+  using namespace info::parse;
+  using test_allocations::countAllocations;
+
+  BOOST_AUTO_TEST_CASE(Test_Allocations_CountingWorks) {
+      BOOST_CHECK_EQUAL(countAllocations([] {
+        auto leak = new int(4);
+        delete leak;
+      }), 1u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Allocations_RepeatedArgvParseDoesNotAllocate) {
+      bool verbose = false, color = false;
+      int level = 0;
+      double ratio = 0;
+      std::string include;
+      std::size_t seen = 0;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("verbose|v", &verbose)
+                    ("color|c", &color)
+                    ("level|l", &level)
+                    ("ratio|r", &ratio)
+                    ("include|I", &include);
+      parser.addOption<void, std::string_view>("define|D", [&](std::string_view value) {
+        seen += value.size();
+      });
+
+      const char* argv[] = {"cc", "-vc", "--level=3", "-r", "0.75", "-I/usr/include/long/enough/to/allocate",
+                            "--define", "NDEBUG", "--no-color", "main.c", "-x"};
+      int argc = static_cast<int>(std::size(argv));
+      std::vector<std::string_view> rest;
+      parser.parse(argc, argv, rest); // warm up
+
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        rest.clear();
+        parser.parse(argc, argv, rest);
+      }), 0u);
+      BOOST_CHECK(verbose);
+      BOOST_CHECK(color);
+      BOOST_CHECK_EQUAL(level, 3);
+      BOOST_CHECK_EQUAL(ratio, 0.75);
+      BOOST_CHECK_EQUAL(include, "/usr/include/long/enough/to/allocate");
+      BOOST_CHECK_EQUAL(rest.size(), 4u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Allocations_RepeatedCompiledParseDoesNotAllocate) {
+      int level = 0;
+      bool verbose = false;
+      std::string include;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("level|l", &level)
+                    ("verbose|v", &verbose)
+                    ("include|I", &include);
+      auto compiled = parser.compile();
+
+      std::string line = " cc  -vl 3 \t--include=/usr/include/long/enough/to/allocate main.c  other.c ";
+      const char* argv[] = {"cc", "-v", "--level", "3", "main.c"};
+      ParseResult result;
+      compiled.parse(line, result); // warm up
+      compiled.parse(5, argv, result);
+      compiled.parse(line, result);
+
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        compiled.parse(line, result);
+      }), 0u);
+      BOOST_CHECK_EQUAL(result.rest(), " cc main.c other.c ");
+      BOOST_CHECK_EQUAL(result.size(), 3u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Allocations_RepeatedStaticParseDoesNotAllocate) {
+      static constexpr auto table = makeOptionTable("level|l", "verbose|v");
+      int level = 0;
+      bool verbose = false;
+      StaticOptionsParser parser(table);
+      parser.addOption(0, &level)
+            .addOption(1, &verbose);
+
+      const char* argv[] = {"cc", "-v", "--level", "3", "main.c"};
+      std::vector<std::string_view> rest;
+      parser.parse(5, argv, rest);
+
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        rest.clear();
+        parser.parse(5, argv, rest);
+      }), 0u);
+      BOOST_CHECK_EQUAL(level, 3);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Allocations_RepeatedParseWithManyOptionsDoesNotAllocate) {
+      constexpr std::size_t count = 300;
+      bool flags[count] = {};
+      OptionsParser parser;
+      for (std::size_t i = 0; i < count; ++i) {
+          parser.addOption("flag-" + std::to_string(i), &flags[i]);
+      }
+      auto compiled = parser.compile();
+
+      const char* argv[] = {"cc", "--flag-0", "--flag-299", "--flag-299", "main.c"};
+      int argc = static_cast<int>(std::size(argv));
+      std::string line = "cc --flag-0 --flag-299 --flag-299 main.c";
+      std::vector<std::string_view> rest;
+      ParseResult result;
+      parser.parse(argc, argv, rest); // warm up
+      compiled.parse(line, result);
+
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        rest.clear();
+        parser.parse(argc, argv, rest);
+      }), 0u);
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        compiled.parse(line, result);
+      }), 0u);
+      BOOST_CHECK(flags[0]);
+      BOOST_CHECK(flags[299]);
+      // the second --flag-299 is left alone, as the first one was marked used
+      BOOST_CHECK_EQUAL(rest.size(), 3u);
+      BOOST_CHECK_EQUAL(result.rest(), " cc --flag-299 main.c ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Allocations_CopyingNamesDoesNotAllocate) {
+      detail::OptionString names("include-directory|include|I");
+      std::size_t length = 0;
+
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        auto copy = names;
+        for (auto&& name : copy.getNames()) {
+            length += name.size();
+        }
+      }), 0u);
+      BOOST_CHECK_EQUAL(length, 28u);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
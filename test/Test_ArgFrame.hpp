@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <string_view>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_ArgFrame)
+  using namespace info::parse;
+
+  BOOST_AUTO_TEST_CASE(Test_ArgFrame_RoundTripsAnyBytes) {
+      std::string big(300, 'x');
+      std::string nul("a\0b", 3);
+      std::vector<std::string_view> args{"--text", " spaced  $1$ \\$ ", "", nul, big};
+      std::string frames;
+      encodeArgs(args, frames);
+      encodeArgs({"second"}, frames);
+
+      std::vector<std::string_view> decoded;
+      auto size = decodeArgs(frames, decoded);
+      BOOST_CHECK(decoded == args);
+      // one byte for the count and each short length, two for 300
+      BOOST_CHECK_EQUAL(size, 1 + 1 + 6 + 1 + 16 + 1 + 1 + 3 + 2 + 300);
+
+      decoded.clear();
+      BOOST_CHECK_EQUAL(decodeArgs(std::string_view(frames).substr(size), decoded), 8u);
+      BOOST_REQUIRE_EQUAL(decoded.size(), 1u);
+      BOOST_CHECK_EQUAL(decoded[0], "second");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ArgFrame_EncodesArgv) {
+      const char* argv[] = {"-l", "3"};
+      std::string frames;
+      encodeArgs(2, argv, frames);
+      BOOST_CHECK_EQUAL(frames, std::string("\x02\x02-l\x01" "3", 6));
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ArgFrame_ParsesFramesInPlace) {
+      int level = 0;
+      std::string name;
+      std::string_view script;
+      OptionsParser parser;
+      parser.addOption("level|l", &level)
+            .addOption("name|n", &name)
+            .addOption<void, std::string_view>("script|s", [&](std::string_view value) { script = value; });
+
+      std::string frames;
+      encodeArgs({"--level", "4", "--script", "a  b\n\tc", "file one"}, frames);
+      encodeArgs({"-n", "two  words", "-l", "5"}, frames);
+
+      std::vector<std::string_view> rest;
+      std::string_view left(frames);
+      left.remove_prefix(parser.parseFrame(left, rest));
+      BOOST_CHECK_EQUAL(level, 4);
+      BOOST_CHECK_EQUAL(script, "a  b\n\tc");
+      BOOST_CHECK(script.data() >= frames.data() && script.data() < frames.data() + frames.size());
+      BOOST_REQUIRE_EQUAL(rest.size(), 1u);
+      BOOST_CHECK_EQUAL(rest[0], "file one");
+
+      left.remove_prefix(parser.parseFrame(left, rest));
+      BOOST_CHECK(left.empty());
+      BOOST_CHECK_EQUAL(level, 5);
+      BOOST_CHECK_EQUAL(name, "two  words");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ArgFrame_CompiledParserParsesFrames) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      auto compiled = parser.compile();
+
+      std::string frames;
+      encodeArgs({"--level", "6", "rest"}, frames);
+      ParseResult result;
+      BOOST_CHECK_EQUAL(compiled.parseFrame(frames, result), frames.size());
+      BOOST_CHECK(result.get<int>(0) == 6);
+      BOOST_CHECK_EQUAL(result.rest(), " rest ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ArgFrame_MalformedFramesChangeNothing) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+
+      std::string frames;
+      encodeArgs({"--level", "7"}, frames);
+      std::vector<std::string_view> rest;
+      BOOST_CHECK_THROW(parser.parseFrame(std::string_view(frames).substr(0, frames.size() - 1), rest),
+                        std::invalid_argument);
+      BOOST_CHECK_EQUAL(level, 0);
+      BOOST_CHECK_THROW(parser.parseFrame("", rest), std::invalid_argument);
+      BOOST_CHECK_THROW(parser.parseFrame(std::string(11, '\xff'), rest), std::invalid_argument);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ArgFrame_TruncatedFramesAppendNothing) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+
+      std::string frames;
+      encodeArgs({"first", "second", "--level", "7"}, frames);
+      auto truncated = std::string_view(frames).substr(0, frames.size() - 1);
+      std::vector<std::string_view> rest{"kept"};
+      BOOST_CHECK_THROW(parser.parseFrame(truncated, rest), std::invalid_argument);
+      BOOST_CHECK(rest == std::vector<std::string_view>{"kept"});
+      BOOST_CHECK_EQUAL(level, 0);
+
+      std::vector<std::string_view> args{"kept"};
+      BOOST_CHECK_THROW(decodeArgs(truncated, args), std::invalid_argument);
+      BOOST_CHECK(args == std::vector<std::string_view>{"kept"});
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <chrono>
+#include <string>
+#include <stdexcept>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+#include "../include/info/parse/StaticOptionsParser.hpp"
+
+namespace test_callback_policy {
+  inline int calls = 0;
+
+  /// Fails, C style, until called the third time
+  inline int failTwice(int) {
+      return ++calls < 3 ? -1 : 0;
+  }
+
+  inline int destroyed = 0;
+
+  /// Counts its destructions
+  struct Tracked {
+      ~Tracked() { ++destroyed; }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(Test_CallbackPolicy)
+  using namespace info::parse;
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_SucceedingCallbacksAreCalledOnce) {
+      int boolCalls = 0, intCalls = 0, pointerCalls = 0;
+      static int target = 0;
+      OptionsParser parser;
+      parser.addOption<bool, int>("bool|b", [&](int) { ++boolCalls; return true; })
+            .addOption<int, int>("int|i", [&](int) { ++intCalls; return 0; })
+            .addOption<int*, int>("pointer|p", [&](int) { ++pointerCalls; return &target; });
+      parser.parse(" --bool 1 --int 2 --pointer 3 ");
+      BOOST_CHECK_EQUAL(boolCalls, 1);
+      BOOST_CHECK_EQUAL(intCalls, 1);
+      BOOST_CHECK_EQUAL(pointerCalls, 1);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_FailingCallbacksAreCalledOnceByDefault) {
+      int calls = 0;
+      OptionsParser parser;
+      parser.addOption<bool, int>("fail|f", [&](int) { ++calls; return false; });
+      parser.parse(" --fail 1 ");
+      BOOST_CHECK_EQUAL(calls, config::RetryFailedCallback ? 2 : 1);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_RetriesUntilSuccess) {
+      int calls = 0;
+      OptionsParser parser;
+      parser.addOption<bool, int>("flaky|f", [&](int) { return ++calls == 2; })
+            .withPolicy(CallbackPolicy::retry(5));
+      parser.parse(" --flaky 1 ");
+      BOOST_CHECK_EQUAL(calls, 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_RetriesAreBounded) {
+      int calls = 0;
+      OptionsParser parser;
+      parser.addOption<void*, int>("broken|b", [&](int) -> void* { ++calls; return nullptr; })
+            .withPolicy(CallbackPolicy::retry(3));
+      parser.parse(" --broken 1 ");
+      BOOST_CHECK_EQUAL(calls, 3);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_BackoffDoubles) {
+      int calls = 0;
+      OptionsParser parser;
+      parser.addOption<bool, int>("slow|s", [&](int) { ++calls; return false; })
+            .withPolicy(CallbackPolicy::retry(3, std::chrono::milliseconds(5)));
+      auto start = std::chrono::steady_clock::now();
+      parser.parse(" --slow 1 ");
+      auto waited = std::chrono::steady_clock::now() - start;
+      BOOST_CHECK_EQUAL(calls, 3);
+      BOOST_CHECK(waited >= std::chrono::milliseconds(15));
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_BackoffIsCapped) {
+      using std::chrono::milliseconds;
+      BOOST_CHECK(detail::nextBackoff(milliseconds(5)) == milliseconds(10));
+      BOOST_CHECK(detail::nextBackoff(CallbackPolicy::maxBackoff - milliseconds(1))
+                  == CallbackPolicy::maxBackoff);
+      BOOST_CHECK(detail::nextBackoff(CallbackPolicy::maxBackoff) == CallbackPolicy::maxBackoff);
+      BOOST_CHECK(detail::nextBackoff(milliseconds::max()) == milliseconds::max());
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_OnlyObjectsAreDeleted) {
+      using test_callback_policy::Tracked;
+      test_callback_policy::destroyed = 0;
+      detail::callWithPolicy<true>(CallbackPolicy::once(), [] { return new Tracked; });
+      BOOST_CHECK_EQUAL(test_callback_policy::destroyed, 1);
+
+      detail::callWithPolicy<false>(CallbackPolicy::once(), [] { return static_cast<Tracked*>(nullptr); });
+      static Tracked kept;
+      detail::callWithPolicy<false>(CallbackPolicy::once(), [] { return &kept; });
+      BOOST_CHECK_EQUAL(test_callback_policy::destroyed, 1);
+
+      // would be deleting a string literal
+      detail::callWithPolicy<true>(CallbackPolicy::once(), [] { return "literal"; });
+      static_assert(!detail::is_deletable_return_v<const char*>);
+      static_assert(!detail::is_deletable_return_v<wchar_t*>);
+      static_assert(!detail::is_deletable_return_v<void*>);
+      static_assert(detail::is_deletable_return_v<const int*>);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_ExceptionsAreNotRetried) {
+      int calls = 0;
+      OptionsParser parser;
+      parser.addOption<bool, int>("throws|t", [&](int) -> bool {
+        ++calls;
+        throw std::runtime_error("no");
+      }).withPolicy(CallbackPolicy::retry(3));
+      BOOST_CHECK_THROW(parser.parse(" --throws 1 "), std::runtime_error);
+      BOOST_CHECK_EQUAL(calls, 1);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_FunctionPointersFollowThePolicy) {
+      test_callback_policy::calls = 0;
+      OptionsParser parser;
+      parser.addOption("once|o", &test_callback_policy::failTwice)
+            .withPolicy(CallbackPolicy::once());
+      parser.parse(" --once 1 ");
+      BOOST_CHECK_EQUAL(test_callback_policy::calls, 1);
+
+      test_callback_policy::calls = 0;
+      OptionsParser retrying;
+      retrying.addOption("retry|r", &test_callback_policy::failTwice)
+              .withPolicy(CallbackPolicy::retry(5));
+      retrying.parse(" --retry 1 ");
+      BOOST_CHECK_EQUAL(test_callback_policy::calls, 3);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_StaticParserFollowsThePolicy) {
+      static constexpr auto table = makeOptionTable("flaky|f");
+      int calls = 0;
+      StaticOptionsParser parser(table);
+      parser.addOption<bool, int>(0, [&](int) { return ++calls == 2; })
+            .withPolicy(0, CallbackPolicy::retry(4));
+      const char* argv[] = {"-f", "1"};
+      std::vector<std::string_view> rest;
+      parser.parse(2, argv, rest);
+      BOOST_CHECK_EQUAL(calls, 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CallbackPolicy_PolicyNeedsAnOption) {
+      OptionsParser parser;
+      BOOST_CHECK_THROW(parser.withPolicy(CallbackPolicy::once()), std::out_of_range);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
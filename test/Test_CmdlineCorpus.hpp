@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_CmdlineCorpus)
+  using namespace info::parse;
+  using namespace std::string_view_literals;
+
+  BOOST_AUTO_TEST_CASE(Test_CmdlineCorpus_SplitsRecordsAndArguments) {
+      auto data = "prog\0--level\0" "3\0\0\0\0other\0-v\0\0last\0tail"sv;
+      auto corpus = CmdlineCorpus::inMemory(data);
+      std::vector<std::string_view> args;
+
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"prog", "--level", "3"}));
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"other", "-v"}));
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"last", "tail"}));
+      BOOST_CHECK(!corpus.next(args));
+      BOOST_CHECK(args.empty());
+
+      corpus.rewind();
+      std::string_view record;
+      BOOST_REQUIRE(corpus.next(record));
+      BOOST_CHECK_EQUAL(record, "prog\0--level\0" "3\0"sv);
+      BOOST_CHECK_EQUAL(record.data(), data.data());
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CmdlineCorpus_EmptyArgumentsSplitRecords) {
+      // prog "" x, then prog "" "" y, as their cmdline files hold them
+      auto data = "prog\0\0x\0\0prog\0\0\0y\0\0"sv;
+      auto corpus = CmdlineCorpus::inMemory(data);
+      std::vector<std::string_view> args;
+
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"prog"}));
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"x"}));
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"prog"}));
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(args == (std::vector<std::string_view>{"y"}));
+      BOOST_CHECK(!corpus.next(args));
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CmdlineCorpus_FeedsTheParserFromAFile) {
+      auto path = (std::filesystem::temp_directory_path() / "ip_test_corpus.bin").string();
+      {
+          std::ofstream file(path, std::ios::binary);
+          auto data = "cc\0-l\0" "1\0a b\0\0cc\0--level\0" "2\0\0"sv;
+          file.write(data.data(), static_cast<std::streamsize>(data.size()));
+      }
+
+      std::vector<int> levels;
+      std::vector<std::string_view> args, rest;
+      OptionsParser parser;
+      parser.addOption<void, int>("level|l", [&](int level) { levels.push_back(level); });
+      {
+          CmdlineCorpus mapped(path);
+          CmdlineCorpus corpus(std::move(mapped));
+          while (corpus.next(args)) {
+              parser.parse(args, rest);
+          }
+          BOOST_CHECK(levels == (std::vector<int>{1, 2}));
+          BOOST_CHECK(rest == (std::vector<std::string_view>{"cc", "a b", "cc"}));
+
+          corpus.rewind();
+          BOOST_REQUIRE(corpus.next(args));
+          ParseResult result;
+          parser.compile().parse(args, result);
+          BOOST_CHECK(result.get<int>(0) == 1);
+          BOOST_CHECK_EQUAL(result.rest(), " cc a$1$b ");
+      }
+      std::remove(path.c_str());
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CmdlineCorpus_MissingFilesThrow) {
+      BOOST_CHECK_THROW(CmdlineCorpus("/nonexistent/ip_test_corpus.bin"), std::system_error);
+  }
+
+#ifdef __linux__
+  BOOST_AUTO_TEST_CASE(Test_CmdlineCorpus_ReadsProcFiles) {
+      CmdlineCorpus corpus("/proc/self/cmdline");
+      std::vector<std::string_view> args;
+      BOOST_REQUIRE(corpus.next(args));
+      BOOST_CHECK(!args.empty());
+      BOOST_CHECK(args[0].find("ip_test") != std::string_view::npos);
+      // buffered contents survive moving
+      CmdlineCorpus moved(std::move(corpus));
+      moved.rewind();
+      std::vector<std::string_view> again;
+      BOOST_REQUIRE(moved.next(again));
+      BOOST_CHECK(again == args);
+  }
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
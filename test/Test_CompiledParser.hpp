@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_CompiledParser)
+  using namespace info::parse;
+
+  BOOST_AUTO_TEST_CASE(Test_CompiledParser_ParsesStringLikeParser) {
+      std::string include;
+      int level = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("level|l", &level)
+                    ("verbose|v", &verbose);
+      auto compiled = parser.compile();
+
+      auto result = compiled.parse("prog -v --include=dir tail");
+      BOOST_CHECK_EQUAL(*result.find(0), "dir");
+      BOOST_CHECK(!result.find(1));
+      BOOST_CHECK_EQUAL(*result.get<bool>(2), true);
+      BOOST_CHECK_EQUAL(result.rest(), " prog tail ");
+      BOOST_CHECK(include.empty());
+      BOOST_CHECK(!verbose);
+
+      parser.apply(result);
+      BOOST_CHECK_EQUAL(include, "dir");
+      BOOST_CHECK(verbose);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CompiledParser_ParsesArgv) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      auto compiled = parser.compile();
+
+      const char* argv[] = {"prog", "-l", "5", "file"};
+      auto result = compiled.parse(4, argv);
+      BOOST_CHECK_EQUAL(*result.get<int>(0), 5);
+      BOOST_CHECK_EQUAL(result.rest(), " prog file ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CompiledParser_ArgvRestIsEscapedLikeParsers) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      auto compiled = parser.compile();
+
+      char* argv[] = {const_cast<char*>("prog"), const_cast<char*>("a  b"),
+                      const_cast<char*>("-l"), const_cast<char*>("5"), const_cast<char*>("$x")};
+      auto expected = parser.parse(5, argv);
+      BOOST_CHECK_EQUAL(expected, " prog a$2$b \\$x ");
+      BOOST_CHECK_EQUAL(compiled.parse(5, argv).rest(), expected);
+
+      ParseResult result;
+      compiled.parse(std::vector<std::string_view>{"prog", "a  b", "-l", "5", "$x"}, result);
+      BOOST_CHECK_EQUAL(result.rest(), expected);
+      // a string is escaped already
+      BOOST_CHECK_EQUAL(compiled.parse("prog a$2$b -l 5 \\$x").rest(), expected);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CompiledParser_ResultIsOverwritten) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      auto compiled = parser.compile();
+
+      ParseResult result;
+      compiled.parse("--level 3 a", result);
+      compiled.parse("b", result);
+      BOOST_CHECK_EQUAL(result.size(), 0u);
+      BOOST_CHECK_EQUAL(result.rest(), " b ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CompiledParser_LaterOptionsAreNotCompiled) {
+      int a = 0, b = 0;
+      OptionsParser parser;
+      parser.addOption("alpha|a", &a);
+      auto compiled = parser.compile();
+      parser.addOption("beta|b", &b);
+
+      auto result = compiled.parse("--alpha 1 --beta 2");
+      BOOST_CHECK_EQUAL(result.size(), 1u);
+      BOOST_CHECK_EQUAL(result.rest(), " --beta 2 ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_CompiledParser_SharedByThreads) {
+      std::string include;
+      int level = 0;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("level|l", &level);
+      const auto compiled = parser.compile();
+
+      std::atomic<int> failures{0};
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 8; ++t) {
+          threads.emplace_back([&, t] {
+            ParseResult result;
+            for (int i = 0; i < 500; ++i) {
+                auto dir = "dir" + std::to_string(t * 1000 + i);
+                compiled.parse("cc -I " + dir + " --level=" + std::to_string(i) + " x.c", result);
+                if (result.find(0) != std::string_view(dir)
+                    || result.get<int>(1) != i
+                    || result.rest() != " cc x.c ")
+                    ++failures;
+            }
+          });
+      }
+      for (auto&& thread : threads) {
+          thread.join();
+      }
+      BOOST_CHECK_EQUAL(failures.load(), 0);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <condition_variable>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_EventDispatch)
+  using namespace info::parse;
+
+  /// Runs each task on a thread of its own
+  struct ThreadExecutor {
+      ~ThreadExecutor() {
+          for (auto&& thread : threads) {
+              thread.join();
+          }
+      }
+
+      Executor executor() {
+          return [this](std::function<void()> task) {
+            threads.emplace_back(std::move(task));
+          };
+      }
+
+      std::vector<std::thread> threads;
+  };
+
+  /// A log written by multiple threads
+  struct Log {
+      void add(const std::string& entry) {
+          std::lock_guard<std::mutex> lock(mutex);
+          entries.push_back(entry);
+      }
+
+      std::mutex mutex;
+      std::vector<std::string> entries;
+  };
+
+  BOOST_AUTO_TEST_CASE(Test_EventDispatch_ValuesAreDispatchedAfterScanning) {
+      std::vector<std::string_view> rest;
+      std::size_t restWhenCalled = 0;
+      OptionsParser parser;
+      parser.addOption<void, int>("first|f", [&](int) { restWhenCalled = rest.size(); });
+      const char* argv[] = {"-f", "1", "a", "b", "c"};
+      parser.parse(5, argv, rest);
+      BOOST_CHECK_EQUAL(restWhenCalled, 3u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_EventDispatch_CallbacksCanParseAgain) {
+      int level = 0;
+      std::string name;
+      OptionsParser parser;
+      parser.addOption("level|l", &level)
+            .addOption("name|n", &name);
+      parser.addOption<void, const std::string&>("config|c", [&](const std::string& file) {
+        parser.parse(" --level 7 --name " + file + " ");
+      });
+      auto rest = parser.parse(" --config cfg tail ");
+      BOOST_CHECK_EQUAL(level, 7);
+      BOOST_CHECK_EQUAL(name, "cfg");
+      BOOST_CHECK_EQUAL(rest, " tail ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_EventDispatch_IndependentCallbacksRunInParallel) {
+      std::mutex mutex;
+      std::condition_variable cv;
+      int arrived = 0;
+      bool sawOther[2] = {};
+      auto meet = [&](int who) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++arrived;
+        cv.notify_all();
+        sawOther[who] = cv.wait_for(lock, std::chrono::seconds(5), [&] { return arrived == 2; });
+      };
+
+      ThreadExecutor pool;
+      OptionsParser parser;
+      parser.setExecutor(pool.executor());
+      parser.addOption<void, int>("alpha|a", [&](int) { meet(0); }).independent();
+      parser.addOption<void, int>("beta|b", [&](int) { meet(1); }).independent();
+      parser.parse(" --alpha 1 --beta 2 ");
+      BOOST_CHECK(sawOther[0]);
+      BOOST_CHECK(sawOther[1]);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_EventDispatch_OtherCallbacksAreBarriers) {
+      Log log;
+      ThreadExecutor pool;
+      OptionsParser parser;
+      parser.setExecutor(pool.executor());
+      parser.addOption<void, int>("slow|s", [&](int) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        log.add("slow");
+      }).independent();
+      parser.addOption<void, int>("ordered|o", [&](int) { log.add("ordered"); });
+      parser.addOption<void, int>("fast|f", [&](int) { log.add("fast"); }).independent();
+      parser.parse(" --slow 1 --ordered 2 --fast 3 ");
+
+      BOOST_REQUIRE_EQUAL(log.entries.size(), 3u);
+      BOOST_CHECK_EQUAL(log.entries[0], "slow");
+      BOOST_CHECK_EQUAL(log.entries[1], "ordered");
+      BOOST_CHECK_EQUAL(log.entries[2], "fast");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_EventDispatch_ExceptionsOfTasksAreRethrown) {
+      ThreadExecutor pool;
+      int after = 0;
+      OptionsParser parser;
+      parser.setExecutor(pool.executor());
+      parser.addOption<void, int>("bad|b", [](int) { throw std::runtime_error("bad"); }).independent();
+      parser.addOption("after|a", &after);
+      BOOST_CHECK_THROW(parser.parse(" --bad 1 --after 1 "), std::runtime_error);
+      BOOST_CHECK_EQUAL(after, 0);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_EventDispatch_IndependentNeedsAnOption) {
+      OptionsParser parser;
+      BOOST_CHECK_THROW(parser.independent(), std::out_of_range);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Test_Allocations.hpp"
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_InlineFunction)
+  using namespace info::parse;
+  using test_allocations::countAllocations;
+  using Acceptor = detail::InlineFunction_<void(std::string_view)>;
+
+  struct Counted {
+      explicit Counted(int* live) : live(live) { ++*live; }
+
+      Counted(const Counted& cp) : live(cp.live) { ++*live; }
+
+      Counted(Counted&& mv) noexcept : live(mv.live) { ++*live; }
+
+      ~Counted() { --*live; }
+
+      void operator()(std::string_view) const {}
+
+      int* live;
+  };
+
+  BOOST_AUTO_TEST_CASE(Test_InlineFunction_ExportersAreStoredInline) {
+      int i = 0;
+      std::string s;
+      std::function<void(int)> f = [](int) {};
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        Acceptor exporter = detail::Exporter_<int>(&i);
+        Acceptor copy = exporter;
+        Acceptor moved = std::move(copy);
+        moved("12");
+      }), 0u);
+      BOOST_CHECK_EQUAL(i, 12);
+
+      Acceptor text = detail::Exporter_<std::string>(&s);
+      text("value");
+      BOOST_CHECK_EQUAL(s, "value");
+
+      int got = 0;
+      std::function<void(int)> callback = [&](int v) { got = v; };
+      Acceptor call = detail::Exporter_<detail::none, void, int>(callback);
+      BOOST_CHECK_EQUAL(countAllocations([&] {
+        Acceptor copy = std::move(call);
+        copy("7");
+      }), 0u);
+      BOOST_CHECK_EQUAL(got, 7);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_InlineFunction_LargeCallablesGoOnTheHeap) {
+      std::array<char, 256> big{};
+      std::size_t seen = 0;
+      Acceptor large = [big, &seen](std::string_view v) { seen += v.size() + big[0]; };
+      Acceptor copy = large;
+      large("ab");
+      copy("abc");
+      BOOST_CHECK_EQUAL(seen, 5u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_InlineFunction_CopiesAndDestroysStoredCallables) {
+      int live = 0;
+      {
+          Acceptor a = Counted(&live);
+          BOOST_CHECK_EQUAL(live, 1);
+          Acceptor b = a;
+          BOOST_CHECK_EQUAL(live, 2);
+          Acceptor c = std::move(a);
+          BOOST_CHECK_EQUAL(live, 2);
+          BOOST_CHECK(!a);
+          b = c;
+          BOOST_CHECK_EQUAL(live, 2);
+          c = Acceptor();
+          BOOST_CHECK_EQUAL(live, 1);
+          BOOST_CHECK(b);
+      }
+      BOOST_CHECK_EQUAL(live, 0);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
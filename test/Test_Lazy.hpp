@@ -8,6 +8,11 @@
 #pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
 #pragma ide diagnostic ignored "cert-err58-cpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
 #include <boost/test/included/unit_test.hpp>
 #include "../include/info/parse/Lazy.hpp"
 
@@ -66,6 +71,15 @@ BOOST_AUTO_TEST_SUITE(Test_Lazy)
       BOOST_CHECK_EQUAL(count, 1);
   }
 
+  BOOST_AUTO_TEST_CASE(Test_Lazy_ResetInstantiatesAgain) {
+      int count = 0;
+      Lazy<int> l([&]() { return std::make_shared<int>(++count); });
+      BOOST_REQUIRE_EQUAL(l.get(), 1);
+      l.reset();
+      BOOST_CHECK(!l.isInited());
+      BOOST_CHECK_EQUAL(l.get(), 2);
+  }
+
   BOOST_AUTO_TEST_CASE(Test_Lazy_DereferenceOperatorEqualsGetMethod) {
       Lazy<int> l([]() { return std::make_shared<int>(5); });
       BOOST_CHECK_EQUAL(*l, 5);
@@ -104,4 +118,117 @@ BOOST_AUTO_TEST_SUITE(Test_Lazy)
       BOOST_CHECK_THROW(auto i = l->i, bad_lazy_eval);
   }
 
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineIniterIsOnlyCalledOnce) {
+      int count = 0;
+      auto l = makeLazy<Foo, int>([&](int i) {
+        ++count;
+        return Foo(i);
+      });
+      BOOST_REQUIRE(!l.isInited());
+      BOOST_REQUIRE_EQUAL(l(4).i, 4);
+      BOOST_CHECK_EQUAL(l(5).i, 4);
+      BOOST_CHECK_EQUAL(l->i, 4);
+      BOOST_CHECK_EQUAL(count, 1);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineValueIsStoredInTheObject) {
+      auto l = makeLazy<int>([] { return 5; });
+      auto object = reinterpret_cast<const char*>(&l);
+      auto value = reinterpret_cast<const char*>(&*l);
+      BOOST_CHECK(value >= object && value < object + sizeof l);
+      BOOST_CHECK_EQUAL(*l, 5);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineTakesPointerIniters) {
+      auto l = makeLazy<int>([] { return std::make_shared<int>(5); });
+      int i = l;
+      BOOST_CHECK_EQUAL(i, 5);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineThrowingIniterIsCalledAgain) {
+      int count = 0;
+      auto l = makeLazy<int>([&] {
+        if (++count == 1)
+            throw std::runtime_error("first");
+        return count;
+      });
+      BOOST_CHECK_THROW((void) l.get(), std::runtime_error);
+      BOOST_CHECK(!l.isInited());
+      BOOST_CHECK_EQUAL(l.get(), 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineCopiesAndResets) {
+      int count = 0;
+      auto l = makeLazy<int>([&] { return ++count; });
+      BOOST_REQUIRE_EQUAL(l.get(), 1);
+      auto copy = l;
+      BOOST_CHECK(copy.isInited());
+      BOOST_CHECK_EQUAL(copy.get(), 1);
+      l.reset();
+      BOOST_CHECK(!l.isInited());
+      BOOST_CHECK_EQUAL(l.get(), 2);
+      BOOST_CHECK_EQUAL(copy.get(), 1);
+  }
+
+  struct ThrowingMoveIniter {
+      ThrowingMoveIniter() = default;
+      ThrowingMoveIniter(const ThrowingMoveIniter&) = default;
+      ThrowingMoveIniter(ThrowingMoveIniter&&) noexcept(false) {}
+
+      int operator()() const { return 0; }
+  };
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineAssignmentReplacesTheIniter) {
+      // a lambda with captures cannot be assigned, only constructed
+      int base = 10;
+      auto make = [&](int add) {
+        return makeLazy<int>([add, &base] { return base + add; });
+      };
+      auto l = make(1);
+      auto other = make(2);
+      l = other;
+      BOOST_CHECK(!l.isInited());
+      BOOST_CHECK_EQUAL(l.get(), 12);
+      l = make(3);
+      BOOST_CHECK_EQUAL(l.get(), 13);
+
+      static_assert(std::is_nothrow_move_assignable_v<decltype(l)>);
+      static_assert(!std::is_nothrow_move_assignable_v<InlineLazy<int, ThrowingMoveIniter>>);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineDereferenceThrowsWhenTRequiresArgs) {
+      auto l = makeLazy<int, int>([](int i) { return i; });
+      BOOST_CHECK_THROW((void) *l, bad_lazy_eval);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Lazy_InlineFirstGetFromManyThreadsCallsIniterOnce) {
+      std::atomic<int> count{0};
+      std::atomic<bool> go{false};
+      auto l = makeLazy<std::vector<int>>([&] {
+        ++count;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return std::vector<int>(100, 7);
+      });
+
+      std::vector<const std::vector<int>*> seen(8);
+      std::vector<std::thread> threads;
+      for (std::size_t i = 0; i < seen.size(); ++i) {
+          threads.emplace_back([&, i] {
+            until (go.load()) {
+                std::this_thread::yield();
+            }
+            seen[i] = &l.get();
+          });
+      }
+      go = true;
+      for (auto&& thread : threads) {
+          thread.join();
+      }
+      BOOST_CHECK_EQUAL(count.load(), 1);
+      for (auto&& value : seen) {
+          BOOST_CHECK_EQUAL(value, &l.get());
+      }
+      BOOST_CHECK_EQUAL(l->size(), 100u);
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
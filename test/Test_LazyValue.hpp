@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+namespace test_lazy_value {
+  /// Counts how many times values were converted into it
+  struct Counted {
+      static inline int conversions = 0;
+      std::string text;
+  };
+}
+
+template<>
+struct info::parse::ValueParser<test_lazy_value::Counted> {
+    static bool parse(std::string_view value, test_lazy_value::Counted& out) {
+        ++test_lazy_value::Counted::conversions;
+        out.text = std::string(value);
+        return true;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(Test_LazyValue)
+  using namespace info::parse;
+  using test_lazy_value::Counted;
+
+  BOOST_AUTO_TEST_CASE(Test_LazyValue_ConvertsOnlyWhenRead) {
+      Counted::conversions = 0;
+      LazyValue<Counted> read, unread;
+      OptionsParser parser;
+      parser.addOption("read|r", &read)
+            .addOption("unread|u", &unread);
+      parser.parse(" --read alpha --unread beta ");
+      BOOST_CHECK_EQUAL(Counted::conversions, 0);
+      BOOST_CHECK(read.isSet());
+      BOOST_CHECK(!read.isConverted());
+      BOOST_CHECK_EQUAL(read.raw(), "alpha");
+
+      BOOST_CHECK_EQUAL(read->text, "alpha");
+      BOOST_CHECK_EQUAL(read.get().text, "alpha");
+      BOOST_CHECK_EQUAL(Counted::conversions, 1);
+      BOOST_CHECK(read.isConverted());
+      BOOST_CHECK(!unread.isConverted());
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_LazyValue_NotFoundReadsInitialValue) {
+      LazyValue<int> level(3);
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      parser.parse(" other ");
+      BOOST_CHECK(!level.isSet());
+      BOOST_CHECK_EQUAL(*level, 3);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_LazyValue_ConvertsLikeAPlainVariable) {
+      LazyValue<int> lazyLevel;
+      LazyValue<std::string> lazyName;
+      LazyValue<double> lazyEmpty(1.5);
+      int level = 0;
+      std::string name;
+      double empty = 1.5;
+      const char* argv[] = {"--level", "+42", "--name", "two words", "--empty"};
+
+      OptionsParser lazy;
+      lazy.addOption("level", &lazyLevel)
+          .addOption("name", &lazyName)
+          .addOption("empty", &lazyEmpty);
+      std::vector<std::string_view> rest;
+      lazy.parse(5, argv, rest);
+
+      OptionsParser eager;
+      eager.addOption("level", &level)
+           .addOption("name", &name)
+           .addOption("empty", &empty);
+      eager.parse(5, argv, rest);
+
+      BOOST_CHECK_EQUAL(*lazyLevel, level);
+      BOOST_CHECK_EQUAL(*lazyName, name);
+      BOOST_CHECK(lazyEmpty.isSet());
+      BOOST_CHECK_EQUAL(*lazyEmpty, empty);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_LazyValue_LaterParsesReplaceTheValue) {
+      LazyValue<int> level;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      parser.parse(" --level 1 ");
+      BOOST_CHECK_EQUAL(*level, 1);
+      parser.parse(" --level 2 ");
+      BOOST_CHECK(!level.isConverted());
+      BOOST_CHECK_EQUAL(*level, 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_LazyValue_BoolsAreFlags) {
+      LazyValue<bool> verbose, color(true);
+      OptionsParser parser;
+      parser.addOption("verbose|v", &verbose)
+            .addOption("color", &color);
+      parser.parse(" -v --no-color file ");
+      BOOST_CHECK(*verbose);
+      BOOST_CHECK(!*color);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <string>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/NameTrie_.hpp"
+#include "../include/info/parse/OptionIndex_.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_NameTrie)
+  using namespace info::parse::detail;
+
+  std::size_t lookUp(const NameTrie_& trie, std::string_view name) {
+      auto state = NameTrie_::root;
+      for (char c : name) {
+          state = trie.step(state, c);
+          if (state == NameTrie_::none)
+              return static_cast<std::size_t>(-1);
+      }
+      auto[first, last] = trie.owners(state);
+      return first == last ? static_cast<std::size_t>(-1) : *first;
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_NameTrie_StepLooksUpNames) {
+      NameTrie_ trie;
+      trie.build({{"-alpha", 0}, {"-a", 0}, {"-beta", 1}, {"<>", 2}});
+      BOOST_CHECK_EQUAL(lookUp(trie, "-alpha"), 0u);
+      BOOST_CHECK_EQUAL(lookUp(trie, "-a"), 0u);
+      BOOST_CHECK_EQUAL(lookUp(trie, "-beta"), 1u);
+      BOOST_CHECK_EQUAL(lookUp(trie, "<>"), 2u);
+      BOOST_CHECK_EQUAL(lookUp(trie, "-al"), static_cast<std::size_t>(-1));
+      BOOST_CHECK_EQUAL(lookUp(trie, "-alphas"), static_cast<std::size_t>(-1));
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_NameTrie_NamesAreListedInTrieOrder) {
+      NameTrie_ trie;
+      trie.build({{"-bcd", 1}, {"-abc", 0}, {"-c", 2}});
+      std::vector<std::pair<std::string, std::size_t>> names;
+      trie.names(names);
+      std::vector<std::pair<std::string, std::size_t>> ex{{"-abc", 0}, {"-bcd", 1}, {"-c", 2}};
+      BOOST_CHECK(names == ex);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_NameTrie_SharedNamesReportAllOwners) {
+      NameTrie_ trie;
+      trie.build({{"-x", 3}, {"-x", 1}});
+      auto state = trie.step(trie.step(NameTrie_::root, '-'), 'x');
+      auto[first, last] = trie.owners(state);
+      BOOST_REQUIRE_EQUAL(last - first, 2);
+      BOOST_CHECK_EQUAL(*first, 3);
+      BOOST_CHECK_EQUAL(*(first + 1), 1);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_NameTrie_StepFailsOnUnknownTransition) {
+      NameTrie_ trie;
+      trie.build({{"-a", 0}});
+      BOOST_CHECK(trie.step(NameTrie_::root, 'a') == NameTrie_::none);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_NameTrie_IndexLooksUpExactNamesAndPrefixes) {
+      OptionIndex_ index;
+      index.addOption("text|t", false, [](std::string_view, const CallbackPolicy&) {});
+      index.addOption("text-overlay", false, [](std::string_view, const CallbackPolicy&) {});
+      index.addOption("flag", true, [](std::string_view, const CallbackPolicy&) {});
+      index.freeze();
+      BOOST_CHECK_EQUAL(index.find("-text"), 0);
+      BOOST_CHECK_EQUAL(index.find("-t"), 0);
+      BOOST_CHECK_EQUAL(index.find("-text-overlay"), 1);
+      BOOST_CHECK_EQUAL(index.find("-tex"), OptionIndex_::npos);
+
+      auto[option, length] = index.findValuePrefix("-text-overlayCocaine");
+      BOOST_CHECK_EQUAL(option, 1);
+      BOOST_CHECK_EQUAL(length, 13);
+      BOOST_CHECK_EQUAL(index.findValuePrefix("-flagvalue").first, OptionIndex_::npos);
+      BOOST_CHECK_EQUAL(index.findValuePrefix("-text").first, 0);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_NameTrie_IndexCopiesKeepTheNamesOfTheOriginal) {
+      auto original = std::make_unique<OptionIndex_>();
+      original->addOption(std::string("alpha|a"), false, [](std::string_view, const CallbackPolicy&) {});
+      OptionIndex_ copy = *original;
+      original.reset();
+      // rebuilds the trie from the names the original stored
+      copy.addOption("beta", false, [](std::string_view, const CallbackPolicy&) {});
+      copy.freeze();
+      BOOST_CHECK_EQUAL(copy.find("-alpha"), 0);
+      BOOST_CHECK_EQUAL(copy.find("-a"), 0);
+      BOOST_CHECK_EQUAL(copy.find("-beta"), 1);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
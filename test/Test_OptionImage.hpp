@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <cstdint>
+#include <stdexcept>
+#include <filesystem>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_OptionImage)
+  using namespace info::parse;
+
+  struct Argv {
+      Argv(std::initializer_list<std::string> args)
+              : args(args) {
+          for (auto&& arg : this->args) {
+              ptrs.push_back(const_cast<char*>(arg.c_str()));
+          }
+      }
+
+      int argc() const { return static_cast<int>(ptrs.size()); }
+
+      char** argv() { return ptrs.data(); }
+
+      std::vector<std::string> args;
+      std::vector<char*> ptrs;
+  };
+
+  const std::string& testImage() {
+      static const std::string image = OptionImage::build({"silent|quiet|s", "output|o", "level|l"});
+      return image;
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_OptionsAreFoundByAnyName) {
+      auto image = OptionImage::inMemory(testImage());
+      BOOST_CHECK_EQUAL(image.size(), 3u);
+      BOOST_CHECK_EQUAL(image.option("silent"), 0u);
+      BOOST_CHECK_EQUAL(image.option("quiet"), 0u);
+      BOOST_CHECK_EQUAL(image.option("o"), 1u);
+      BOOST_CHECK_EQUAL(image.option("level"), 2u);
+      BOOST_CHECK_THROW((void) image.option("verbose"), std::out_of_range);
+      BOOST_CHECK_THROW((void) image.option("sil"), std::out_of_range);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_BoundOptionsAreParsed) {
+      bool silent = false;
+      std::string output;
+      auto image = OptionImage::inMemory(testImage());
+      OptionsParser parser(image);
+      parser.addOption(image.option("silent"), &silent)
+            .addOption(image.option("output"), &output);
+
+      Argv args{"--quiet", "--output:", "out.txt", "-l3", "--level", "4"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(silent);
+      BOOST_CHECK_EQUAL(output, "out.txt");
+      // level is not bound
+      BOOST_CHECK_EQUAL(rest, " -l3 --level 4 ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_ParsesLikeOptionsAddedByName) {
+      auto run = [](OptionsParser& parser, auto&& bind) {
+        bool silent = false;
+        std::string output;
+        int level = 0;
+        bind(parser, silent, output, level);
+        Argv args{"x", "-sl7", "-ofile", "--no-silent", "--level=2", "y"};
+        auto rest = parser.parse(args.argc(), args.argv());
+        return rest + std::to_string(silent) + output + std::to_string(level);
+      };
+
+      OptionsParser byName;
+      auto expected = run(byName, [](OptionsParser& parser, bool& s, std::string& o, int& l) {
+        parser.addOption("silent|quiet|s", &s)
+              .addOption("output|o", &o)
+              .addOption("level|l", &l);
+      });
+      auto image = OptionImage::inMemory(testImage());
+      OptionsParser fromImage(image);
+      auto actual = run(fromImage, [](OptionsParser& parser, bool& s, std::string& o, int& l) {
+        parser.addOption(0, &s)
+              .addOption(1, &o)
+              .addOption(2, &l);
+      });
+      BOOST_CHECK_EQUAL(actual, expected);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_FileIsMapped) {
+      auto path = (std::filesystem::temp_directory_path() / "ip_test_options.img").string();
+      {
+          std::ofstream file(path, std::ios::binary);
+          file << testImage();
+      }
+      std::string output;
+      {
+          OptionImage image(path);
+          BOOST_CHECK(image.data() == testImage());
+          OptionsParser parser(image);
+          parser.addOption(image.option("o"), &output);
+          Argv args{"-oout"};
+          parser.parse(args.argc(), args.argv());
+      }
+      std::filesystem::remove(path);
+      BOOST_CHECK_EQUAL(output, "out");
+      BOOST_CHECK_THROW(OptionImage image(path), std::system_error);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_MisalignedImageIsCopied) {
+      std::string shifted = " " + testImage();
+      auto image = OptionImage::inMemory(std::string_view(shifted).substr(1));
+      BOOST_CHECK_EQUAL(image.option("level"), 2u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_MalformedImagesAreRejected) {
+      auto reject = [](std::string bytes) {
+        BOOST_CHECK_THROW(OptionImage::inMemory(bytes), std::invalid_argument);
+      };
+      auto& image = testImage();
+      reject("");
+      reject(image.substr(0, 16));
+      reject(image.substr(0, image.size() - 4));
+
+      auto badMagic = image;
+      badMagic[0] = 'X';
+      reject(badMagic);
+
+      // the header, then the amounts of states, edges and owners
+      std::uint32_t states;
+      std::memcpy(&states, image.data() + 24, 4);
+      auto edges = 24 + 12 + states * 20;
+      auto badTarget = image;
+      std::uint32_t target = 1000000;
+      std::memcpy(&badTarget[edges + 4], &target, 4);
+      reject(badTarget);
+
+      auto badOwner = image;
+      std::uint32_t owner = 3;
+      std::memcpy(&badOwner[badOwner.size() - 4], &owner, 4);
+      reject(badOwner);
+
+      // seven names, so there cannot be eight options
+      auto tooManyOptions = image;
+      std::uint32_t options = 8;
+      std::memcpy(&tooManyOptions[20], &options, 4);
+      reject(tooManyOptions);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_OptionsWithoutNamesAreRejected) {
+      BOOST_CHECK_THROW((void) OptionImage::build({"output|o", ""}), std::invalid_argument);
+      BOOST_CHECK_THROW((void) OptionImage::build({"||"}), std::invalid_argument);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_OptionsCanBeAddedByName) {
+      bool silent = false;
+      int extra = 0;
+      auto image = OptionImage::inMemory(testImage());
+      OptionsParser parser(image);
+      parser.addOption(image.option("s"), &silent)
+            .addOption("extra|e", &extra);
+      Argv args{"--quiet", "-e5", "-o", "x"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(silent);
+      BOOST_CHECK_EQUAL(extra, 5);
+      BOOST_CHECK_EQUAL(rest, " -o x ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_PolicyAppliesToTheBoundOption) {
+      int calls = 0;
+      auto image = OptionImage::inMemory(testImage());
+      OptionsParser parser(image);
+      parser.addOption<bool, int>(image.option("level"), [&](int) {
+        ++calls;
+        return false;
+      }).withPolicy(CallbackPolicy::retry(3));
+      Argv args{"-l1"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(calls, 3);
+      BOOST_CHECK_THROW(OptionsParser(image).withPolicy(CallbackPolicy::once()), std::out_of_range);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionImage_CompiledParsersUseTheImage) {
+      int level = 0;
+      auto image = OptionImage::inMemory(testImage());
+      OptionsParser parser(image);
+      parser.addOption(image.option("level"), &level);
+      auto compiled = parser.compile();
+      auto result = compiled.parse("-l 9 -s");
+      BOOST_REQUIRE(result.get<int>(2));
+      BOOST_CHECK_EQUAL(*result.get<int>(2), 9);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
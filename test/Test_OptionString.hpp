@@ -50,6 +50,19 @@ BOOST_AUTO_TEST_SUITE(Test_OptionString)
       BOOST_CHECK(!os.hasShort());
   }
 
+  BOOST_AUTO_TEST_CASE(Test_OptionString_CopiesShareTheirStorage) {
+      OptionString os("apple|a|<>");
+      OptionString same(std::string("apple|a|<>"));
+      OptionString other("apple|a");
+      BOOST_CHECK(os == same);
+      BOOST_CHECK(os != other);
+      OptionString copy = os;
+      BOOST_CHECK_EQUAL(os.getNames().begin(), copy.getNames().begin());
+      BOOST_CHECK_EQUAL(static_cast<const void*>(os[0].data()), static_cast<const void*>(copy[0].data()));
+      BOOST_CHECK_EQUAL(os[2], "<>");
+      BOOST_CHECK_THROW((void) os[3], std::out_of_range);
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #pragma clang diagnostic pop
@@ -165,6 +165,30 @@ BOOST_AUTO_TEST_SUITE(Test_OptionsParser)
       BOOST_CHECK_EQUAL(s, "text");
   }
 
+  BOOST_AUTO_TEST_CASE(Test_OptionsParser_StringRemainderKeepsUnmatchedArguments) {
+      std::string include;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("verbose|v", &verbose);
+      auto rest = parser.parse(" prog -I a -I b --verbose \t tail --verbose ");
+      BOOST_CHECK_EQUAL(include, "a");
+      BOOST_CHECK(verbose);
+      BOOST_CHECK_EQUAL(rest, " prog -I b tail --verbose ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_OptionsParser_StringRemainderIsFramedBySpaces) {
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOption("verbose|v", &verbose);
+      // until 2.1.x the remainder was "prog a b", without the frame
+      BOOST_CHECK_EQUAL(parser.parse("prog a b"), " prog a b ");
+      BOOST_CHECK_EQUAL(parser.parse("prog -v a  b"), " prog a b ");
+      BOOST_CHECK_EQUAL(parser.parse("-v"), " ");
+      BOOST_CHECK_EQUAL(parser.parse(""), " ");
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #pragma clang diagnostic pop
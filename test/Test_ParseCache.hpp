@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <vector>
+#include <string>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_ParseCache)
+  using namespace info::parse;
+
+  struct Argv {
+      Argv(std::initializer_list<std::string> args)
+              : args(args) {
+          for (auto&& arg : this->args) {
+              ptrs.push_back(const_cast<char*>(arg.c_str()));
+          }
+      }
+
+      int argc() const { return static_cast<int>(ptrs.size()); }
+
+      char** argv() { return ptrs.data(); }
+
+      std::vector<std::string> args;
+      std::vector<char*> ptrs;
+  };
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_DisabledByDefault) {
+      int n = 0;
+      OptionsParser parser;
+      parser.addOption("num|n", &n);
+      Argv args{"-n1"};
+      parser.parse(args.argc(), args.argv());
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 0u);
+      BOOST_CHECK_EQUAL(parser.cacheStats().misses, 0u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_HitReplaysValuesAndCallbacks) {
+      bool verbose = false;
+      int level = 0;
+      std::vector<std::string> names;
+      OptionsParser parser;
+      parser.addOption("verbose|v", &verbose)
+            .addOption("level|l", &level)
+            .addOption<void, const std::string&>("name", [&](const std::string& name) {
+              names.push_back(name);
+            })
+            .cacheResults(8);
+
+      for (int i = 0; i < 3; ++i) {
+          verbose = false;
+          level = 0;
+          Argv args{"prog", "-v", "--level:", "4", "--name=x", "file"};
+          auto rest = parser.parse(args.argc(), args.argv());
+          BOOST_CHECK(verbose);
+          BOOST_CHECK_EQUAL(level, 4);
+          BOOST_CHECK_EQUAL(rest, " prog file ");
+      }
+      BOOST_CHECK(names == std::vector<std::string>(3, "x"));
+      BOOST_CHECK_EQUAL(parser.cacheStats().misses, 1u);
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 2u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_HitGivesViewsIntoTheArgumentsGiven) {
+      std::string_view value;
+      OptionsParser parser;
+      parser.addOption<void, std::string_view>("name|n", [&](std::string_view v) {
+        value = v;
+      }).cacheResults(8);
+
+      std::vector<std::string> first{"-nabc", "left"};
+      std::vector<std::string> second(first);
+      std::vector<std::string_view> rest;
+      parser.parse(std::vector<std::string_view>(first.begin(), first.end()), rest);
+      rest.clear();
+      parser.parse(std::vector<std::string_view>(second.begin(), second.end()), rest);
+
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 1u);
+      BOOST_CHECK_EQUAL(value, "abc");
+      BOOST_CHECK(value.data() == second[0].data() + 2);
+      BOOST_REQUIRE_EQUAL(rest.size(), 1u);
+      BOOST_CHECK(rest[0].data() == second[1].data());
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_DifferentArgumentsMiss) {
+      int n = 0;
+      OptionsParser parser;
+      parser.addOption("num|n", &n).cacheResults(8);
+      Argv one{"-n1"}, two{"-n2"}, split{"-n", "1"};
+      parser.parse(one.argc(), one.argv());
+      parser.parse(two.argc(), two.argv());
+      BOOST_CHECK_EQUAL(n, 2);
+      parser.parse(split.argc(), split.argv());
+      BOOST_CHECK_EQUAL(n, 1);
+      BOOST_CHECK_EQUAL(parser.cacheStats().misses, 3u);
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 0u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_LeastRecentlyUsedIsDropped) {
+      int n = 0;
+      OptionsParser parser;
+      parser.addOption("num|n", &n).cacheResults(2);
+      Argv a{"-n1"}, b{"-n2"}, c{"-n3"};
+      auto parse = [&](Argv& args) { parser.parse(args.argc(), args.argv()); };
+
+      parse(a);
+      parse(b);
+      parse(a); // hit, b is now the oldest
+      parse(c); // drops b
+      parse(a); // hit
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 2u);
+      parse(b);
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 2u);
+      BOOST_CHECK_EQUAL(parser.cacheStats().misses, 4u);
+      BOOST_CHECK_EQUAL(n, 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_AddingAnOptionEmptiesTheCache) {
+      int n = 0;
+      int m = 0;
+      OptionsParser parser;
+      parser.addOption("num|n", &n).cacheResults(8);
+      Argv args{"-n1", "-m2"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(rest, " -m2 ");
+
+      parser.addOption("m", &m);
+      rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(rest, " ");
+      BOOST_CHECK_EQUAL(m, 2);
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 0u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_FlagsAndFinishedValuesAreReplayed) {
+      bool on = false, off = true;
+      std::string last = "unset";
+      OptionsParser parser;
+      parser.addOption("on", &on)
+            .addOption("off", &off)
+            .addOption("last", &last)
+            .cacheResults(8);
+      for (int i = 0; i < 2; ++i) {
+          on = false;
+          off = true;
+          last = "unset";
+          Argv args{"--on", "--no-off", "--last:"};
+          parser.parse(args.argc(), args.argv());
+          BOOST_CHECK(on);
+          BOOST_CHECK(!off);
+          BOOST_CHECK(last.empty());
+      }
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 1u);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseCache_ShrinkingDropsResults) {
+      int n = 0;
+      OptionsParser parser;
+      parser.addOption("num|n", &n).cacheResults(8);
+      Argv args{"-n1"};
+      parser.parse(args.argc(), args.argv());
+      parser.cacheResults(0).cacheResults(8);
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(parser.cacheStats().hits, 0u);
+      BOOST_CHECK_EQUAL(parser.cacheStats().misses, 2u);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <thread>
+#include <stdexcept>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_ParseMany)
+  using namespace info::parse;
+
+  BOOST_AUTO_TEST_CASE(Test_ParseMany_ResultsHoldValuesAndRest) {
+      std::string include;
+      int level = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("level|l", &level)
+                    ("verbose|v", &verbose);
+
+      std::vector<std::string> lines{"prog -I a --level=3 tail",
+                                     "prog -vl 7",
+                                     "prog"};
+      auto results = parser.parseMany(lines);
+      BOOST_REQUIRE_EQUAL(results.size(), 3u);
+
+      BOOST_CHECK_EQUAL(results[0].size(), 2u);
+      BOOST_CHECK_EQUAL(*results[0].find(0), "a");
+      BOOST_CHECK_EQUAL(*results[0].get<int>(1), 3);
+      BOOST_CHECK(!results[0].find(2));
+      BOOST_CHECK_EQUAL(results[0].rest(), " prog tail ");
+
+      BOOST_CHECK_EQUAL(*results[1].find(2), "1");
+      BOOST_CHECK_EQUAL(*results[1].get<int>(1), 7);
+      BOOST_CHECK_EQUAL(results[1].rest(), " prog ");
+
+      BOOST_CHECK_EQUAL(results[2].size(), 0u);
+      BOOST_CHECK_EQUAL(results[2].rest(), " prog ");
+
+      // nothing is exported until applied
+      BOOST_CHECK(include.empty());
+      BOOST_CHECK_EQUAL(level, 0);
+      BOOST_CHECK(!verbose);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseMany_ApplyExportsLikeParse) {
+      std::string include;
+      int level = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("level|l", &level)
+                    ("verbose|v", &verbose);
+
+      auto results = parser.parseMany(std::vector<std::string>{"-v --include dir --level 4"});
+      parser.apply(results[0]);
+      BOOST_CHECK_EQUAL(include, "dir");
+      BOOST_CHECK_EQUAL(level, 4);
+      BOOST_CHECK(verbose);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseMany_MatchesSingleParsesAcrossThreads) {
+      std::string include, define;
+      int level = 0;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("define|D", &define)
+                    ("level|l", &level)
+                    ("verbose|v", &verbose);
+
+      std::vector<std::string> lines;
+      for (int i = 0; i < 2000; ++i) {
+          std::string line = "prog";
+          for (int j = 0; j < i % 7; ++j) {
+              line += " file" + std::to_string(j);
+          }
+          if (i % 2)
+              line += " -I inc" + std::to_string(i);
+          if (i % 3)
+              line += " --define=D" + std::to_string(i);
+          if (i % 5)
+              line += " -vl" + std::to_string(i % 10);
+          lines.push_back(line);
+      }
+
+      auto results = parser.parseMany(lines, 4);
+      BOOST_REQUIRE_EQUAL(results.size(), lines.size());
+      for (std::size_t i = 0; i < lines.size(); ++i) {
+          include.clear();
+          define.clear();
+          level = 0;
+          verbose = false;
+          auto rest = parser.parse(lines[i]);
+          auto expInclude = include, expDefine = define;
+          auto expLevel = level;
+          auto expVerbose = verbose;
+
+          include.clear();
+          define.clear();
+          level = 0;
+          verbose = false;
+          parser.apply(results[i]);
+          BOOST_CHECK_EQUAL(results[i].rest(), rest);
+          BOOST_CHECK_EQUAL(include, expInclude);
+          BOOST_CHECK_EQUAL(define, expDefine);
+          BOOST_CHECK_EQUAL(level, expLevel);
+          BOOST_CHECK_EQUAL(verbose, expVerbose);
+      }
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseMany_WorkPoolDoesEveryItemOnce) {
+      detail::WorkPool_ pool(8, 3);
+      std::vector<std::atomic<int>> done(1001);
+      pool.run(done.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            ++done[i];
+        }
+      });
+      for (auto&& count : done) {
+          BOOST_CHECK_EQUAL(count.load(), 1);
+      }
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseMany_WorkPoolRethrows) {
+      detail::WorkPool_ pool(4, 1);
+      BOOST_CHECK_THROW(pool.run(100, [](std::size_t, std::size_t begin, std::size_t) {
+        if (begin == 42)
+            throw std::runtime_error("42");
+      }), std::runtime_error);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseMany_WorkPoolKeepsItsThreads) {
+      constexpr std::size_t workers = 4;
+      detail::WorkPool_ pool(workers, 1);
+      // counts the batches each thread worked on
+      thread_local std::size_t batches = 0;
+      std::atomic<std::size_t> arrived{0};
+      std::vector<std::size_t> seen(workers);
+
+      for (std::size_t batch = 1; batch <= 2; ++batch) {
+          arrived = 0;
+          pool.run(workers, [&](std::size_t worker, std::size_t, std::size_t) {
+            // each worker takes one item, as none returns before all came
+            ++arrived;
+            while (arrived.load() < workers) {
+                std::this_thread::yield();
+            }
+            seen[worker] = ++batches;
+          });
+          for (auto&& count : seen) {
+              BOOST_CHECK_EQUAL(count, batch);
+          }
+      }
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
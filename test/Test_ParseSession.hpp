@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <vector>
+#include <string>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_ParseSession)
+  using namespace info::parse;
+
+  struct Argv {
+      Argv(std::initializer_list<std::string> args)
+              : args(args) {
+          for (auto&& arg : this->args) {
+              ptrs.push_back(const_cast<char*>(arg.c_str()));
+          }
+      }
+
+      int argc() const { return static_cast<int>(ptrs.size()); }
+
+      char** argv() { return ptrs.data(); }
+
+      std::vector<std::string> args;
+      std::vector<char*> ptrs;
+  };
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_FlagsAreSet) {
+      bool a = false, b = false, c = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("alpha|a", &a)
+                    ("beta|b", &b)
+                    ("gamma|g", &c);
+      Argv args{"prog", "--alpha", "-g"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(a);
+      BOOST_CHECK(!b);
+      BOOST_CHECK(c);
+      BOOST_CHECK_EQUAL(rest, " prog ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_NegatedFlagIsCleared) {
+      bool a = true;
+      OptionsParser parser;
+      parser.addOption("alpha|a", &a);
+      Argv args{"--no-alpha"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(!a);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_FlagsTakeTruthyValues) {
+      bool a = true, b = false, c = true, d = true;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("alpha|a", &a)
+                    ("beta|b", &b)
+                    ("gamma|g", &c)
+                    ("delta|d", &d);
+      Argv args{"--alpha=No", "-b:yes", "--gamma:", "0", "--delta:"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(!a);
+      BOOST_CHECK(b);
+      BOOST_CHECK(!c);
+      BOOST_CHECK(!d);
+      BOOST_CHECK_EQUAL(rest, " ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_FlagsDoNotTakeNextArgument) {
+      bool a = false;
+      OptionsParser parser;
+      parser.addOption("alpha|a", &a);
+      Argv args{"--alpha", "text"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(a);
+      BOOST_CHECK_EQUAL(rest, " text ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_ValuesAreTakenInAllForms) {
+      std::string a, b, c, d, e, f;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("word|w", &a)
+                    ("other|o", &b)
+                    ("third|t", &c)
+                    ("fourth", &d)
+                    ("fifth", &e)
+                    ("sixth", &f);
+      Argv args{"--wordval", "--other", "val", "-t=val", "--fourth:", "val", "--fifth:val", "--sixth="};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(a, "val");
+      BOOST_CHECK_EQUAL(b, "val");
+      BOOST_CHECK_EQUAL(c, "val");
+      BOOST_CHECK_EQUAL(d, "val");
+      BOOST_CHECK_EQUAL(e, "val");
+      BOOST_CHECK_EQUAL(f, "");
+      BOOST_CHECK_EQUAL(rest, " ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_EqualsSignDoesNotSeek) {
+      std::string a = "x";
+      OptionsParser parser;
+      parser.addOption("word", &a);
+      Argv args{"--word=", "val"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(a, "");
+      BOOST_CHECK_EQUAL(rest, " val ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_ValueAtEndIsEmpty) {
+      int a = 4;
+      OptionsParser parser;
+      parser.addOption("alpha|a", &a);
+      Argv args{"-a"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(a, 0);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_ValuesKeepTheirWhitespace) {
+      std::string a;
+      OptionsParser parser;
+      parser.addOption("script|s", &a);
+      Argv args{"--script", "echo  a $b"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(a, "echo  a $b");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_BundlesAreExploded) {
+      int a = 0;
+      bool d = false, s = false, o = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("alpha|a", &a)
+                    ("die|d", &d)
+                    ("sleep|s", &s)
+                    ("observe|o", &o);
+      Argv args{"-dsa", "42"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(a, 42);
+      BOOST_CHECK(d);
+      BOOST_CHECK(s);
+      BOOST_CHECK(!o);
+      BOOST_CHECK_EQUAL(rest, " ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_BundleTakesGluedValue) {
+      std::string include;
+      bool verbose = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("include|I", &include)
+                    ("verbose|v", &verbose);
+      Argv args{"-vI/usr/include"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(verbose);
+      BOOST_CHECK_EQUAL(include, "/usr/include");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_RepeatedFlagsInABundleAreSet) {
+      bool v = false, c = false;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("verbose|v", &v)
+                    ("color|c", &c);
+      Argv args{"-vv", "x"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(v);
+      BOOST_CHECK_EQUAL(rest, " x ");
+
+      v = false;
+      Argv more{"-vvc"};
+      rest = parser.parse(more.argc(), more.argv());
+      BOOST_CHECK(v);
+      BOOST_CHECK(c);
+      BOOST_CHECK_EQUAL(rest, " ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_SingleDashLongNamesParseTheSameFromAString) {
+      for (int fromString = 0; fromString < 2; ++fromString) {
+          bool quiet = false, q = false, u = false, i = false, e = false, t = false;
+          std::string output;
+          OptionsParser parser;
+          parser.addOptions()
+                        ("quiet", &quiet)
+                        ("q", &q)("u", &u)("i", &i)("e", &e)("t", &t)
+                        ("output", &output);
+          std::string rest;
+          if (fromString) {
+              rest = parser.parse(" prog -quiet -output=out.txt -ut ");
+          } else {
+              Argv args{"prog", "-quiet", "-output=out.txt", "-ut"};
+              rest = parser.parse(args.argc(), args.argv());
+          }
+          BOOST_TEST_CONTEXT("from " << (fromString ? "a string" : "argv")) {
+              BOOST_CHECK(quiet);
+              BOOST_CHECK_EQUAL(output, "out.txt");
+              BOOST_CHECK(!q);
+              BOOST_CHECK(!i);
+              BOOST_CHECK(!e);
+              BOOST_CHECK(u);
+              BOOST_CHECK(t);
+          }
+      }
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_UnknownBundleIsLeftAlone) {
+      bool d = false;
+      OptionsParser parser;
+      parser.addOption("die|d", &d);
+      Argv args{"-dx"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(!d);
+      BOOST_CHECK_EQUAL(rest, " -dx ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_EmptyNamesDoNotMatchALoneDash) {
+      bool quiet = false;
+      OptionsParser parser;
+      parser.addOption("quiet||q|", &quiet);
+      Argv args{"cat", "-", "x"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK(!quiet);
+      BOOST_CHECK_EQUAL(rest, " cat - x ");
+      BOOST_CHECK_EQUAL(parser.parse("cat - -q"), " cat - ");
+      BOOST_CHECK(quiet);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_LongestNameWinsRegardlessOfOrder) {
+      std::string text, overlay;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("text", &text)
+                    ("text-overlay", &overlay);
+      Argv args{"--text-overlay=Cocaine"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(text, "");
+      BOOST_CHECK_EQUAL(overlay, "Cocaine");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_OptionsAreOnlyMatchedOnce) {
+      int a = 0;
+      OptionsParser parser;
+      parser.addOption("alpha|a", &a);
+      Argv args{"-a", "1", "--alpha", "2"};
+      auto rest = parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(a, 1);
+      BOOST_CHECK_EQUAL(rest, " --alpha 2 ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_CallbacksAreCalled) {
+      std::string s;
+      int i = 0;
+      OptionsParser parser;
+      parser.addOption<void, const std::string&>("value", [&](const std::string& s_) {
+        s = s_;
+      });
+      parser.addOption<void, int>("number", [&](int i_) {
+        i = i_;
+      });
+      Argv args{"--value=text", "--number", "42"};
+      parser.parse(args.argc(), args.argv());
+      BOOST_CHECK_EQUAL(s, "text");
+      BOOST_CHECK_EQUAL(i, 42);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_ViewsPointIntoArgv) {
+      std::string_view value;
+      OptionsParser parser;
+      parser.addOption<void, std::string_view>("value|v", [&](std::string_view v) {
+        value = v;
+      });
+      const char* argv[]{"prog", "--value=text", "rest"};
+      std::vector<std::string_view> rest;
+      parser.parse(3, argv, rest);
+      BOOST_CHECK_EQUAL(value, "text");
+      BOOST_CHECK(value.data() == argv[1] + 8);
+      BOOST_REQUIRE_EQUAL(rest.size(), 2);
+      BOOST_CHECK(rest[0].data() == argv[0]);
+      BOOST_CHECK(rest[1].data() == argv[2]);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseSession_RestIsAppendedTo) {
+      bool a = false;
+      OptionsParser parser;
+      parser.addOption("alpha|a", &a);
+      const char* argv[]{"x", "-a", "y"};
+      std::vector<std::string_view> rest{"before"};
+      parser.parse(3, argv, rest);
+      BOOST_CHECK(a);
+      BOOST_REQUIRE_EQUAL(rest.size(), 3);
+      BOOST_CHECK_EQUAL(rest[2], "y");
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
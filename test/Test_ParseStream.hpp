@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <vector>
+#include <string>
+#include <tuple>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_ParseStream)
+  using namespace info::parse;
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_ValuesAreHandedOverWhenComplete) {
+      bool verbose = false;
+      int level = 0;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("verbose|v", &verbose)
+                    ("level|l", &level);
+      auto stream = parser.stream();
+      stream.feed("-v");
+      BOOST_CHECK(verbose);
+      stream.feed("--level=3");
+      BOOST_CHECK_EQUAL(level, 3);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_ColonWaitsForTheNextArgument) {
+      std::string output;
+      OptionsParser parser;
+      parser.addOption("output|o", &output);
+      auto stream = parser.stream();
+      stream.feed("--output:");
+      BOOST_CHECK(stream.pending());
+      BOOST_CHECK(output.empty());
+      stream.feed("out.txt");
+      BOOST_CHECK(!stream.pending());
+      BOOST_CHECK_EQUAL(output, "out.txt");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_SpaceWaitsForTheNextArgument) {
+      std::string output;
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("output|o", &output)
+            .addOption("level|l", &level);
+      auto stream = parser.stream();
+      stream.feed("-o").feed("a.txt").feed("--level").feed("2");
+      BOOST_CHECK_EQUAL(output, "a.txt");
+      BOOST_CHECK_EQUAL(level, 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_BundleWaitsForTheNextArgument) {
+      bool a = false;
+      std::string output;
+      OptionsParser parser;
+      parser.addOption("a", &a)
+            .addOption("o", &output);
+      auto stream = parser.stream();
+      stream.feed("-ao");
+      BOOST_CHECK(a);
+      BOOST_CHECK(stream.pending());
+      stream.feed("x");
+      BOOST_CHECK_EQUAL(output, "x");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_FedArgumentsNeedNotOutliveTheCall) {
+      std::string copy;
+      OptionsParser parser;
+      parser.addOption("name|n", &copy);
+      auto stream = parser.stream();
+      {
+          std::string arg = "--name:";
+          stream.feed(arg);
+      }
+      {
+          std::string arg = "value";
+          std::string left = "left";
+          stream.feed(arg).feed(left);
+          arg.assign(arg.size(), '#');
+          left.assign(left.size(), '#');
+      }
+      BOOST_CHECK_EQUAL(copy, "value");
+      BOOST_REQUIRE_EQUAL(stream.rest().size(), 1u);
+      BOOST_CHECK_EQUAL(stream.rest()[0], "left");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_FinishSettlesThePendingOption) {
+      bool flag = true;
+      std::string output = "unset";
+      OptionsParser parser;
+      parser.addOption("flag|f", &flag)
+            .addOption("output|o", &output);
+      auto stream = parser.stream();
+      stream.feed("--output:");
+      stream.finish();
+      BOOST_CHECK(output.empty());
+      BOOST_CHECK(!stream.pending());
+
+      stream.reset();
+      stream.feed("--flag:");
+      stream.finish();
+      BOOST_CHECK(!flag);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_ResetStartsAnotherCommandLine) {
+      int level = 0;
+      OptionsParser parser;
+      parser.addOption("level|l", &level);
+      auto stream = parser.stream();
+      stream.feed("-l1").feed("-l2");
+      BOOST_CHECK_EQUAL(level, 1);
+      BOOST_REQUIRE_EQUAL(stream.rest().size(), 1u);
+      BOOST_CHECK_EQUAL(stream.rest()[0], "-l2");
+
+      stream.reset();
+      BOOST_CHECK(stream.rest().empty());
+      stream.feed("-l2");
+      BOOST_CHECK_EQUAL(level, 2);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_MatchesParsingArgv) {
+      auto run = [](auto&& parse) {
+        bool a = false, b = false;
+        int n = 0;
+        std::string s;
+        OptionsParser parser;
+        parser.addOptions()
+                      ("alpha|a", &a)
+                      ("beta|b", &b)
+                      ("num|n", &n)
+                      ("str|s", &s);
+        auto rest = parse(parser);
+        return std::make_tuple(a, b, n, s, rest);
+      };
+      std::vector<std::string> args{"x", "-ab", "--num:", "12", "--no-beta", "-s", "v", "y"};
+
+      auto fromArgv = run([&](OptionsParser& parser) {
+        std::vector<std::string_view> views(args.begin(), args.end()), rest;
+        parser.parse(views, rest);
+        return std::vector<std::string>(rest.begin(), rest.end());
+      });
+      auto fromStream = run([&](OptionsParser& parser) {
+        auto stream = parser.stream();
+        for (auto&& arg : args) {
+            stream.feed(arg);
+        }
+        stream.finish();
+        return stream.rest();
+      });
+      BOOST_CHECK(fromArgv == fromStream);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ParseStream_CanBeMoved) {
+      std::string output;
+      OptionsParser parser;
+      parser.addOption("output|o", &output);
+      auto first = parser.stream();
+      first.feed("-o");
+      auto second = std::move(first);
+      second.feed("moved");
+      BOOST_CHECK_EQUAL(output, "moved");
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/StaticOptionsParser.hpp"
+
+BOOST_AUTO_TEST_SUITE(Test_StaticOptionsParser)
+  using namespace info::parse;
+
+  constexpr detail::StaticOptionString staticNames("quiet|silent||q|s|<>");
+  static_assert(staticNames.size() == 5);
+  static_assert(staticNames[0] == "-quiet");
+  static_assert(staticNames[2] == "-q");
+  static_assert(staticNames[4] == "<>");
+  static_assert(staticNames.hasShort());
+
+  constexpr auto staticTable = makeOptionTable("alpha|a", "text|t", "text-overlay", "all|a", "<>");
+  static_assert(staticTable.find("-alpha") == 0);
+  static_assert(staticTable.find("-a") == 0);
+  static_assert(staticTable.find("-text-overlay") == 2);
+  static_assert(staticTable.find("-all") == 3);
+  static_assert(staticTable.find("<>") == 4);
+  static_assert(staticTable.find("-tex") == staticTable.npos);
+  static_assert(staticTable.find("alpha") == staticTable.npos);
+  static_assert(staticTable.option("t") == 1);
+  static_assert(staticTable.option("<>") == 4);
+  static_assert(staticTable.option("-t") == staticTable.npos);
+  static_assert(staticTable.size() == 7);
+
+  BOOST_AUTO_TEST_CASE(Test_StaticOptionsParser_StaticOptionStringMatchesOptionString) {
+      detail::OptionString names("quiet|silent|q|s|<>");
+      constexpr detail::StaticOptionString same("quiet|silent|q|s|<>");
+      BOOST_REQUIRE_EQUAL(names.getNames().size(), same.size());
+      for (std::size_t i = 0; i < same.size(); ++i) {
+          BOOST_CHECK_EQUAL(names[i], same[i]);
+      }
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_StaticOptionsParser_ManyNamesAreAllFound) {
+      constexpr auto table = makeOptionTable(
+              "a0|b0|c0|d0|e0|f0|g0|h0", "a1|b1|c1|d1|e1|f1|g1|h1", "a2|b2|c2|d2|e2|f2|g2|h2",
+              "a3|b3|c3|d3|e3|f3|g3|h3", "a4|b4|c4|d4|e4|f4|g4|h4", "a5|b5|c5|d5|e5|f5|g5|h5",
+              "a6|b6|c6|d6|e6|f6|g6|h6", "a7|b7|c7|d7|e7|f7|g7|h7", "a8|b8|c8|d8|e8|f8|g8|h8"
+      );
+      for (std::size_t option = 0; option < 9; ++option) {
+          for (char c = 'a'; c <= 'h'; ++c) {
+              char name[] = {'-', c, static_cast<char>('0' + option)};
+              BOOST_CHECK_EQUAL(table.find(std::string_view(name, 3)), option);
+          }
+      }
+      BOOST_CHECK_EQUAL(table.find("-i0"), table.npos);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_StaticOptionsParser_ValuesAndFlagsAreParsed) {
+      bool all = false;
+      std::string text, overlay;
+      int alpha = 0;
+      StaticOptionsParser parser(staticTable);
+      parser.addOption(staticTable.option("alpha"), &alpha)
+            .addOption(staticTable.option("text"), &text)
+            .addOption(staticTable.option("text-overlay"), &overlay)
+            .addOption(staticTable.option("all"), &all);
+      char prog[] = "prog", a[] = "-a", four[] = "4", ov[] = "--text-overlayCocaine",
+              al[] = "--all", tx[] = "-t:txt";
+      char* argv[]{prog, a, four, ov, al, tx};
+      auto rest = parser.parse(6, argv);
+      BOOST_CHECK_EQUAL(alpha, 4);
+      BOOST_CHECK_EQUAL(overlay, "Cocaine");
+      BOOST_CHECK_EQUAL(text, "txt");
+      BOOST_CHECK(all);
+      BOOST_CHECK_EQUAL(rest, " prog ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_StaticOptionsParser_UnboundOptionsAreLeftAlone) {
+      std::string text;
+      StaticOptionsParser parser(staticTable);
+      parser.addOption(staticTable.option("text"), &text);
+      const char* argv[]{"--alpha", "--text-overlay=x", "--textval"};
+      std::vector<std::string_view> rest;
+      parser.parse(3, argv, rest);
+      BOOST_CHECK_EQUAL(text, "-overlay=x");
+      BOOST_REQUIRE_EQUAL(rest.size(), 2);
+      BOOST_CHECK_EQUAL(rest[0], "--alpha");
+      BOOST_CHECK_EQUAL(rest[1], "--textval");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_StaticOptionsParser_CallbacksAreCalled) {
+      int got = 0;
+      StaticOptionsParser parser(staticTable);
+      parser.addOption<void, int>(staticTable.option("a"), [&](int i) {
+        got = i;
+      });
+      const char* argv[]{"-a=42"};
+      std::vector<std::string_view> rest;
+      parser.parse(1, argv, rest);
+      BOOST_CHECK_EQUAL(got, 42);
+      BOOST_CHECK(rest.empty());
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_StaticOptionsParser_BindingUnknownOptionThrows) {
+      bool b = false;
+      StaticOptionsParser parser(staticTable);
+      BOOST_CHECK_THROW(parser.addOption(staticTable.option("nope"), &b), std::out_of_range);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop
@@ -18,6 +18,9 @@
 
 #include <vector>
 #include <string>
+#include <regex>
+#include <random>
+#include <locale>
 
 using namespace info::parse;
 
@@ -104,6 +107,31 @@ BOOST_AUTO_TEST_SUITE(Test_Utils)
       BOOST_CHECK_EQUAL(dollary, "asd asd$4$asd2");
   }
 
+  BOOST_AUTO_TEST_CASE(Test_Utils_ItrStrCountsEveryKindOfWhitespace) {
+      std::string script("if x;\n\t then$y \r\n");
+      itrStr(script);
+      BOOST_CHECK_EQUAL(script, "if$1$x;$3$then\\$y$3$");
+      arcItrStr(script);
+      BOOST_CHECK_EQUAL(script, "if x;   then$y   ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Utils_ArcItrStrKeepsItsQuirks) {
+      // a marker needs something other than a backslash before it
+      std::string leading("$2$a");
+      arcItrStr(leading);
+      BOOST_CHECK_EQUAL(leading, "$2$a");
+      std::string afterBackslash(R"(a\$1$)");
+      arcItrStr(afterBackslash);
+      BOOST_CHECK_EQUAL(afterBackslash, "a$1$");
+      std::string huge("a$99999999999$");
+      BOOST_CHECK_THROW(arcItrStr(huge), std::out_of_range);
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Utils_MakeMonolithArgsEscapesEachArgument) {
+      std::vector<std::string_view> args{"a b", "$x", ""};
+      BOOST_CHECK_EQUAL(makeMonolithArgs(args), R"( a$1$b \$x  )");
+  }
+
   class Base {
   };
 
@@ -232,6 +260,109 @@ BOOST_AUTO_TEST_SUITE(Test_Utils)
       BOOST_CHECK_EQUAL(ss.str(), "");
   }
 
+  BOOST_AUTO_TEST_CASE(Test_Utils_CollapseWhitespaceCollapsesRuns) {
+      std::string out("garbage that is longer than the result");
+      collapseWhitespace(" \t-a  \r\n 4\v\f--b\x08c\x0e ", out);
+      BOOST_CHECK_EQUAL(out, " -a 4 --b\x08c\x0e ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Utils_CollapseWhitespaceMatchesRegexOnAllLengths) {
+      // Covers the vectorized blocks, the runs crossing their
+      // borders and the scalar tails after them
+      const char alphabet[] = " \t\n\v\f\r\x08\x0e\x1f\x80\xff-a=";
+      std::mt19937 rng(42);
+      std::uniform_int_distribution<std::size_t> pick(0, sizeof(alphabet) - 2);
+      std::uniform_int_distribution<int> runs(0, 3);
+      std::string out;
+      for (std::size_t length = 0; length < 200; ++length) {
+          std::string in;
+          while (in.size() < length) {
+              // Runs make long stretches of whitespace likely
+              in.append(static_cast<std::size_t>(runs(rng)) * 7 + 1, alphabet[pick(rng)]);
+          }
+          in.resize(length);
+          collapseWhitespace(in, out);
+          BOOST_CHECK_EQUAL(out, std::regex_replace(in, std::regex("\\s+"), " "));
+      }
+  }
+
+  // Makes \xa0, the Latin-1 no-break space, whitespace
+  struct NoBreakSpaceCtype : std::ctype<char> {
+      static const mask* table() {
+          static std::vector<mask> table(classic_table(), classic_table() + table_size);
+          table[0xa0] |= space;
+          return table.data();
+      }
+
+      NoBreakSpaceCtype() : std::ctype<char>(table()) {}
+  };
+
+  BOOST_AUTO_TEST_CASE(Test_Utils_CollapseWhitespaceFollowsLocaleAboveAscii) {
+      auto previous = std::locale::global(std::locale(std::locale::classic(), new NoBreakSpaceCtype));
+      std::string in;
+      for (int i = 0; i < 100; ++i) {
+          in += i % 3 ? "\xa0\xa0-a\x80" : " \xa0" "b\xff";
+      }
+      std::string out;
+      collapseWhitespace(in, out);
+      auto expected = std::regex_replace(in, std::regex("\\s+"), " ");
+      std::locale::global(previous);
+      BOOST_CHECK_EQUAL(out, expected);
+      BOOST_CHECK_EQUAL(expected.find("\xa0"), std::string::npos);
+  }
+
+  // The bundle exploding of the string parser before it was made single pass
+  std::string explodeBundlesReference(const std::string& args) {
+      std::string parsable(args);
+      std::size_t bundleStart = 0;
+      std::string bundleSequence(" -");
+      for (;;) {
+          bundleStart = parsable.find(bundleSequence, bundleStart);
+          if (bundleStart == std::string::npos) break;
+          if (parsable[bundleStart + 2] == '-' && ++bundleStart) continue;
+
+          std::size_t bundleEnd = parsable.find(' ', bundleStart + 1);
+          std::size_t bundleSize = bundleEnd - bundleStart - 1;
+          if (bundleSize <= 1 && ++bundleStart) continue;
+
+          std::string bundle = parsable.substr(bundleStart, bundleSize + 1);
+          parsable.erase(bundleStart, bundleSize + 1);
+          std::stringstream explodedBundleStream;
+          for (const auto& ch : bundle) {
+              unless (ch == ' ' || ch == '-') {
+                  explodedBundleStream << " -" << ch << ' ';
+              }
+          }
+          parsable.insert(bundleStart, explodedBundleStream.str());
+          bundleStart++;
+      }
+      return parsable;
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Utils_ExplodeBundlesExplodes) {
+      std::string out;
+      explodeBundles(" -abc --long -x - -- -a-b val -", out);
+      BOOST_CHECK_EQUAL(out, " -a  -b   -c   --long -x  - -- -a  -b   val");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_Utils_ExplodeBundlesMatchesReference) {
+      // Long inputs make the vectorized scan find the " -"-s,
+      // short ones the scalar tail
+      const char alphabet[] = "  -ab\t";
+      std::mt19937 rng(42);
+      std::uniform_int_distribution<std::size_t> pick(0, sizeof(alphabet) - 2);
+      std::uniform_int_distribution<std::size_t> lengths(0, 100);
+      std::string out;
+      for (int i = 0; i < 5000; ++i) {
+          std::string in(lengths(rng), ' ');
+          for (auto& c : in) {
+              c = alphabet[pick(rng)];
+          }
+          explodeBundles(in, out);
+          BOOST_CHECK_EQUAL(out, explodeBundlesReference(in));
+      }
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #pragma clang diagnostic pop
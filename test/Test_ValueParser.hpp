@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2019, András Bodor
+ * Licensed under BSD 3-Clause
+ * For more information see the supplied
+ * LICENSE file
+ */
+
+#pragma once
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "MemberFunctionCanBeStaticInspection"
+#pragma ide diagnostic ignored "cert-err58-cpp"
+
+#include <string>
+#include <random>
+#include <sstream>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "../include/info/parse/OptionsParser.hpp"
+
+namespace test_value_parser {
+  struct Celsius {
+      double degrees = 0;
+  };
+
+  struct OnlyStreamed {
+      std::string word;
+
+      friend std::istream& operator>>(std::istream& is, OnlyStreamed& s) {
+          return is >> s.word;
+      }
+  };
+
+  struct Opaque {
+  };
+
+  struct Streamed {
+      std::string word;
+
+      friend std::istream& operator>>(std::istream& is, Streamed& s) {
+          return is >> s.word;
+      }
+
+      friend std::ostream& operator<<(std::ostream& os, const Streamed& s) {
+          return os << s.word;
+      }
+  };
+}
+
+template<>
+struct info::parse::ValueParser<test_value_parser::Celsius> {
+    static bool parse(std::string_view value, test_value_parser::Celsius& out) {
+        unless (value.back() == 'C') {
+            return false;
+        }
+        return ValueParser<double>::parse(value.substr(0, value.size() - 1), out.degrees);
+    }
+};
+
+// A specialization from before parse returned whether it succeeded
+template<>
+struct info::parse::ValueParser<test_value_parser::Streamed> {
+    static void parse(std::string_view value, test_value_parser::Streamed& out) {
+        out.word = std::string(value.substr(0, value.find(' ')));
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(Test_ValueParser)
+  using namespace info::parse;
+  using namespace test_value_parser;
+
+  template<class T>
+  T streamed(const std::string& value) {
+      std::istringstream ss(value);
+      T out{};
+      ss >> out;
+      return out;
+  }
+
+  template<class T>
+  T parsed(const std::string& value) {
+      T out{};
+      ValueParser<T>::parse(value, out);
+      return out;
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_NumbersMatchOperatorShift) {
+      const char* values[] = {
+              "0", "42", "-42", "+42", " 7", "12abc", "abc", "-", "+",
+              "99999999999999999999", "-99999999999999999999", "2147483648",
+              "4294967296", "-1", "007", "1.5", "-0.25", "1e3", "1e", "1e+",
+              ".5", "inf", "-inf", "nan", "0x10", "1.5e308", "1e400"
+      };
+      for (auto value : values) {
+          BOOST_TEST_CONTEXT(value) {
+              BOOST_CHECK_EQUAL(parsed<int>(value), streamed<int>(value));
+              BOOST_CHECK_EQUAL(parsed<unsigned>(value), streamed<unsigned>(value));
+              BOOST_CHECK_EQUAL(parsed<long long>(value), streamed<long long>(value));
+              BOOST_CHECK_EQUAL(parsed<unsigned short>(value), streamed<unsigned short>(value));
+              BOOST_CHECK_EQUAL(parsed<double>(value), streamed<double>(value));
+              BOOST_CHECK_EQUAL(parsed<float>(value), streamed<float>(value));
+          }
+      }
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_RandomNumbersMatchOperatorShift) {
+      std::mt19937_64 rng(42);
+      for (int i = 0; i < 2000; ++i) {
+          auto number = static_cast<long long>(rng());
+          auto text = std::to_string(number >> (rng() % 64));
+          BOOST_CHECK_EQUAL(parsed<long long>(text), streamed<long long>(text));
+          BOOST_CHECK_EQUAL(parsed<int>(text), streamed<int>(text));
+
+          std::ostringstream os;
+          os.precision(rng() % 18 + 1);
+          os << std::ldexp(static_cast<double>(number), static_cast<int>(rng() % 200) - 100);
+          BOOST_CHECK_EQUAL(parsed<double>(os.str()), streamed<double>(os.str()));
+      }
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_BoolAndChar) {
+      BOOST_CHECK_EQUAL(parsed<bool>("1"), true);
+      BOOST_CHECK_EQUAL(parsed<bool>("0"), false);
+      BOOST_CHECK_EQUAL(parsed<bool>("2"), streamed<bool>("2"));
+      BOOST_CHECK_EQUAL(parsed<bool>("true"), streamed<bool>("true"));
+      BOOST_CHECK_EQUAL(parsed<char>("xyz"), 'x');
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_StringTakesWholeValue) {
+      BOOST_CHECK_EQUAL(parsed<std::string>("two words"), "two words");
+      BOOST_CHECK_EQUAL(parsed<OnlyStreamed>("two words").word, "two");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_ReportsFailure) {
+      int i = 0;
+      BOOST_CHECK(ValueParser<int>::parse("42", i));
+      BOOST_CHECK(!ValueParser<int>::parse("x42", i));
+      BOOST_CHECK(!ValueParser<int>::parse("99999999999999999999", i));
+      Celsius c;
+      BOOST_CHECK(ValueParser<Celsius>::parse("3C", c));
+      BOOST_CHECK(!ValueParser<Celsius>::parse("3F", c));
+      OnlyStreamed s;
+      BOOST_CHECK(ValueParser<OnlyStreamed>::parse("word", s));
+      BOOST_CHECK(!ValueParser<OnlyStreamed>::parse("   ", s));
+      Streamed legacy;
+      BOOST_CHECK(detail::parseValue(std::string_view("a b"), legacy));
+      BOOST_CHECK_EQUAL(legacy.word, "a");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_ParsableTypesAreOptions) {
+      BOOST_CHECK(detail::can_parse_v<int>);
+      BOOST_CHECK(detail::can_parse_v<std::string>);
+      BOOST_CHECK(detail::can_parse_v<Celsius>);
+      BOOST_CHECK(detail::can_parse_v<OnlyStreamed>);
+      BOOST_CHECK(!detail::can_parse_v<Opaque>);
+
+      Celsius temperature;
+      OnlyStreamed word;
+      OptionsParser parser;
+      parser.addOptions()
+                    ("temp|t", &temperature)
+                    ("word|w", &word);
+      auto rest = parser.parse(" --temp 21.5C -w hello ");
+      BOOST_CHECK_EQUAL(temperature.degrees, 21.5);
+      BOOST_CHECK_EQUAL(word.word, "hello");
+      BOOST_CHECK_EQUAL(rest, " ");
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_InvalidValuesAreNotResults) {
+      Celsius temperature;
+      OptionsParser parser;
+      parser.addOption("temp|t", &temperature);
+      auto compiled = parser.compile();
+      BOOST_CHECK_EQUAL(compiled.parse("--temp 3C").get<Celsius>(0)->degrees, 3);
+      BOOST_CHECK(!compiled.parse("--temp 3F").get<Celsius>(0));
+  }
+
+  BOOST_AUTO_TEST_CASE(Test_ValueParser_SpecializationIsUsedByParser) {
+      Celsius temperature;
+      OptionsParser parser;
+      parser.addOption<void, Celsius>("temp|t", [&](Celsius c) { temperature = c; });
+      parser.parse(" --temp 21.5C ");
+      BOOST_CHECK_EQUAL(temperature.degrees, 21.5);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#pragma clang diagnostic pop